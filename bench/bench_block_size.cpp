@@ -0,0 +1,110 @@
+// 块大小扫描：对小元素与大元素分别比较不同 BlockSize 下的填充、顺序扫描与随机访问
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+template <std::size_t Bytes>
+struct Payload {
+  unsigned char bytes[Bytes];
+};
+
+template <class T>
+T makeValue(std::size_t i) {
+  T value{};
+  reinterpret_cast<unsigned char&>(value) = static_cast<unsigned char>(i);
+  return value;
+}
+
+template <class T>
+unsigned char keyOf(const T& value) {
+  return reinterpret_cast<const unsigned char&>(value);
+}
+
+}  // namespace
+
+template <class T, std::size_t BlockSize>
+using SweepDeque = deque::Deque<T, std::allocator<T>, BlockSize>;
+
+template <class T, std::size_t BlockSize>
+static void BM_FillBack(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    SweepDeque<T, BlockSize> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.pushBack(makeValue<T>(i));
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["block_bytes"] = static_cast<double>(BlockSize * sizeof(T));
+}
+
+template <class T, std::size_t BlockSize>
+static void BM_Scan(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  SweepDeque<T, BlockSize> d;
+  for (std::size_t i = 0; i < count; ++i) {
+    d.pushBack(makeValue<T>(i));
+  }
+  for (auto _ : state) {
+    unsigned long long sum = 0;
+    for (const T& value : d) {
+      sum += keyOf(value);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["block_bytes"] = static_cast<double>(BlockSize * sizeof(T));
+}
+
+template <class T, std::size_t BlockSize>
+static void BM_RandomAccess(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  SweepDeque<T, BlockSize> d;
+  for (std::size_t i = 0; i < count; ++i) {
+    d.pushBack(makeValue<T>(i));
+  }
+  std::vector<std::size_t> indices(4096);
+  std::mt19937_64 rng(42);
+  for (auto& index : indices) {
+    index = static_cast<std::size_t>(rng() % count);
+  }
+  for (auto _ : state) {
+    unsigned long long sum = 0;
+    for (std::size_t index : indices) {
+      sum += keyOf(d[index]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(indices.size()));
+  state.counters["block_bytes"] = static_cast<double>(BlockSize * sizeof(T));
+}
+
+#define DEQUE_BLOCK_SWEEP(T, B)                                            \
+  BENCHMARK_TEMPLATE(BM_FillBack, T, B)->Arg(1 << 20);                    \
+  BENCHMARK_TEMPLATE(BM_Scan, T, B)->Arg(1 << 20);                        \
+  BENCHMARK_TEMPLATE(BM_RandomAccess, T, B)->Arg(1 << 20)
+
+#define DEQUE_BLOCK_SWEEP_ALL(T)                                           \
+  DEQUE_BLOCK_SWEEP(T, 16);                                                \
+  DEQUE_BLOCK_SWEEP(T, 64);                                                \
+  DEQUE_BLOCK_SWEEP(T, 256);                                               \
+  DEQUE_BLOCK_SWEEP(T, 1024);                                              \
+  DEQUE_BLOCK_SWEEP(T, 4096);                                              \
+  DEQUE_BLOCK_SWEEP(T, deque::detail::defaultBlockSize<T>())
+
+using Payload8 = Payload<8>;
+using Payload64 = Payload<64>;
+using Payload256 = Payload<256>;
+
+DEQUE_BLOCK_SWEEP_ALL(char);
+DEQUE_BLOCK_SWEEP_ALL(Payload8);
+DEQUE_BLOCK_SWEEP_ALL(Payload64);
+DEQUE_BLOCK_SWEEP_ALL(Payload256);
@@ -0,0 +1,120 @@
+// 批量装载：append/prepend/区间插入与逐个 pushBack 的对比，以及预留容量后的逐个推入
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+
+static std::vector<int> makeSource(std::size_t count) {
+  std::vector<int> source(count);
+  std::iota(source.begin(), source.end(), 0);
+  return source;
+}
+
+static void BM_PushBackLoop(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    for (int v : source) {
+      d.pushBack(v);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 批量大小事先已知：先一次性预留，循环内的推入不再触发分配。
+static void BM_ReservedPushBackLoop(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    d.reserveBack(source.size());
+    for (int v : source) {
+      d.pushBack(v);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PushFrontLoop(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    for (int v : source) {
+      d.pushFront(v);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ReservedPushFrontLoop(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    d.reserveFront(source.size());
+    for (int v : source) {
+      d.pushFront(v);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Append(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    d.append(source.begin(), source.end());
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Prepend(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::Deque<int> d;
+    d.prepend(source.begin(), source.end());
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_InsertRangeMiddle(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = bench::makeFilled<Container>(1 << 12);
+    state.ResumeTiming();
+    c.insert(c.begin() + (1 << 10), source.begin(), source.end());
+    benchmark::DoNotOptimize(c.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdDequeInsertEnd(benchmark::State& state) {
+  auto source = makeSource(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::deque<int> d;
+    d.insert(d.end(), source.begin(), source.end());
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PushBackLoop)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ReservedPushBackLoop)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PushFrontLoop)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ReservedPushFrontLoop)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Append)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Prepend)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_StdDequeInsertEnd)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_InsertRangeMiddle, deque::Deque<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertRangeMiddle, std::deque<int>)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+// 基准测试共用的适配函数：统一 deque::Deque 与标准容器的接口命名，
+// 让同一个基准模板可以同时实例化在三种容器上。
+namespace bench {
+
+template <class T, class A, std::size_t B>
+inline void pushBack(deque::Deque<T, A, B>& c, const T& v) { c.pushBack(v); }
+template <class T, class A>
+inline void pushBack(std::deque<T, A>& c, const T& v) { c.push_back(v); }
+template <class T, class A>
+inline void pushBack(std::vector<T, A>& c, const T& v) { c.push_back(v); }
+
+template <class T, class A, std::size_t B>
+inline void pushFront(deque::Deque<T, A, B>& c, const T& v) { c.pushFront(v); }
+template <class T, class A>
+inline void pushFront(std::deque<T, A>& c, const T& v) { c.push_front(v); }
+
+template <class T, class A, std::size_t B>
+inline void popBack(deque::Deque<T, A, B>& c) { c.popBack(); }
+template <class T, class A>
+inline void popBack(std::deque<T, A>& c) { c.pop_back(); }
+template <class T, class A>
+inline void popBack(std::vector<T, A>& c) { c.pop_back(); }
+
+template <class T, class A, std::size_t B>
+inline void popFront(deque::Deque<T, A, B>& c) { c.popFront(); }
+template <class T, class A>
+inline void popFront(std::deque<T, A>& c) { c.pop_front(); }
+
+// 固定大小的元素类型，用于按元素尺寸扫描；key 参与比较，其余字节只占空间。
+template <std::size_t Bytes>
+struct Blob {
+  static_assert(Bytes >= sizeof(std::uint64_t), "Blob must hold its key");
+
+  std::uint64_t key = 0;
+  unsigned char padding[Bytes - sizeof(std::uint64_t)] = {};
+
+  Blob() = default;
+  Blob(std::uint64_t k) : key(k) {}
+
+  friend bool operator<(const Blob& lhs, const Blob& rhs) { return lhs.key < rhs.key; }
+  friend bool operator==(const Blob& lhs, const Blob& rhs) { return lhs.key == rhs.key; }
+};
+
+template <class T>
+inline std::uint64_t keyOf(const T& value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return static_cast<std::uint64_t>(value);
+  } else {
+    return value.key;
+  }
+}
+
+template <class Container>
+inline Container makeFilled(std::size_t count) {
+  Container c;
+  for (std::size_t i = 0; i < count; ++i) {
+    pushBack(c, static_cast<typename Container::value_type>(i));
+  }
+  return c;
+}
+
+}  // namespace bench
@@ -0,0 +1,138 @@
+// 多生产者多消费者争用：ConcurrentDeque（双锁 + 批量弹出）与
+// 单把 std::mutex + 条件变量包装的 Deque 对比，总线程数 2..64（生产者与消费者各半）
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deque/concurrent_deque.hpp"
+#include "deque/deque.hpp"
+
+namespace {
+
+constexpr std::size_t transfer_count = 1 << 17;
+constexpr std::size_t queue_capacity = 1024;
+constexpr std::size_t batch_size = 32;
+
+// 基线：整个队列一把锁，接口与 ConcurrentDeque 的子集一致。
+template <class T>
+class MutexBlockingDeque {
+ public:
+  explicit MutexBlockingDeque(std::size_t capacity) : capacity_(capacity) {}
+
+  bool pushBack(const T& value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return closed_ || deque_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    deque_.pushBack(value);
+    not_empty_.notify_one();
+    return true;
+  }
+
+  template <class OutputIt>
+  std::size_t popBulk(OutputIt out, std::size_t max_count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !deque_.empty(); });
+    std::size_t n = 0;
+    for (; n < max_count && !deque_.empty(); ++n, ++out) {
+      *out = deque_.front();
+      deque_.popFront();
+    }
+    if (n > 1) {
+      not_full_.notify_all();
+    } else if (n == 1) {
+      not_full_.notify_one();
+    }
+    return n;
+  }
+
+  bool popFront(T& out) { return popBulk(&out, 1) == 1; }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  deque::Deque<T> deque_;
+  std::size_t capacity_;
+  bool closed_ = false;
+};
+
+template <class Queue>
+void runTransfer(std::size_t thread_count, std::size_t pop_batch) {
+  Queue queue(queue_capacity);
+  const std::size_t producers = std::max<std::size_t>(1, thread_count / 2);
+  const std::size_t consumers = std::max<std::size_t>(1, thread_count - producers);
+  const std::size_t per_producer = transfer_count / producers;
+
+  std::vector<std::thread> producer_threads;
+  for (std::size_t p = 0; p < producers; ++p) {
+    producer_threads.emplace_back([&queue, per_producer] {
+      for (std::size_t i = 0; i < per_producer; ++i) {
+        queue.pushBack(static_cast<std::uint64_t>(i));
+      }
+    });
+  }
+  std::vector<std::thread> consumer_threads;
+  for (std::size_t c = 0; c < consumers; ++c) {
+    consumer_threads.emplace_back([&queue, pop_batch] {
+      std::vector<std::uint64_t> batch(pop_batch);
+      std::uint64_t sum = 0;
+      while (std::size_t n = queue.popBulk(batch.begin(), pop_batch)) {
+        for (std::size_t k = 0; k < n; ++k) {
+          sum += batch[k];
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+  }
+  for (auto& thread : producer_threads) {
+    thread.join();
+  }
+  queue.close();
+  for (auto& thread : consumer_threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+template <class Queue>
+static void BM_ContendedTransfer(benchmark::State& state) {
+  const auto thread_count = static_cast<std::size_t>(state.range(0));
+  const auto pop_batch = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    runTransfer<Queue>(thread_count, pop_batch);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(transfer_count));
+}
+
+static void contentionArgs(benchmark::internal::Benchmark* b) {
+  for (long threads = 2; threads <= 64; threads *= 2) {
+    b->Args({threads, 1});
+    b->Args({threads, static_cast<long>(batch_size)});
+  }
+  b->ArgNames({"threads", "batch"});
+}
+
+BENCHMARK_TEMPLATE(BM_ContendedTransfer, deque::ConcurrentDeque<std::uint64_t>)
+    ->Apply(contentionArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ContendedTransfer, MutexBlockingDeque<std::uint64_t>)
+    ->Apply(contentionArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+// 复制、清空、区间删除：平凡可复制类型的 memcpy/memmove 路径与非平凡类型对比；
+// 以及按批清空再填充（clear() 保留容量）和空容器的构造开销。
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+
+namespace {
+
+struct Quote {
+  long long timestamp;
+  double bid;
+  double ask;
+  int id;
+};
+
+template <class T>
+T makeValue(std::size_t i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(24, static_cast<char>('a' + i % 26));
+  } else if constexpr (std::is_same_v<T, Quote>) {
+    return Quote{static_cast<long long>(i), 1.0, 2.0, static_cast<int>(i)};
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+template <class Container>
+Container makeContainer(std::size_t count) {
+  Container c;
+  for (std::size_t i = 0; i < count; ++i) {
+    bench::pushBack(c, makeValue<typename Container::value_type>(i));
+  }
+  return c;
+}
+
+}  // namespace
+
+template <class Container>
+static void BM_CopyConstruct(benchmark::State& state) {
+  auto source = makeContainer<Container>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Container copy(source);
+    benchmark::DoNotOptimize(&copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_Clear(benchmark::State& state) {
+  auto source = makeContainer<Container>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    c.clear();
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 同一个容器每批先清空再填充 n 个元素：保留容量时稳态下不再分配。
+template <class Container>
+static void BM_ClearRefillBatch(benchmark::State& state) {
+  using T = typename Container::value_type;
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const T value = makeValue<T>(1);
+  Container c;
+  for (auto _ : state) {
+    c.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+      bench::pushBack(c, value);
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 构造并析构一个从未使用过的容器。
+template <class Container>
+static void BM_ConstructEmpty(benchmark::State& state) {
+  for (auto _ : state) {
+    Container c;
+    benchmark::DoNotOptimize(&c);
+  }
+}
+
+template <class Container>
+static void BM_EraseMiddleRange(benchmark::State& state) {
+  auto size = static_cast<std::size_t>(state.range(0));
+  auto source = makeContainer<Container>(size);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    auto first = c.begin() + static_cast<std::ptrdiff_t>(size / 3);
+    c.erase(first, first + static_cast<std::ptrdiff_t>(size / 8));
+    benchmark::DoNotOptimize(&c);
+  }
+}
+
+#define DEQUE_COPY_CLEAR_BENCH(T)                                                        \
+  BENCHMARK_TEMPLATE(BM_CopyConstruct, deque::Deque<T>)->Range(1 << 10, 1 << 20);        \
+  BENCHMARK_TEMPLATE(BM_CopyConstruct, std::deque<T>)->Range(1 << 10, 1 << 20);          \
+  BENCHMARK_TEMPLATE(BM_Clear, deque::Deque<T>)->Range(1 << 10, 1 << 20);                \
+  BENCHMARK_TEMPLATE(BM_Clear, std::deque<T>)->Range(1 << 10, 1 << 20);                  \
+  BENCHMARK_TEMPLATE(BM_EraseMiddleRange, deque::Deque<T>)->Range(1 << 12, 1 << 20);     \
+  BENCHMARK_TEMPLATE(BM_EraseMiddleRange, std::deque<T>)->Range(1 << 12, 1 << 20);       \
+  BENCHMARK_TEMPLATE(BM_ClearRefillBatch, deque::Deque<T>)->Range(1 << 6, 1 << 14);      \
+  BENCHMARK_TEMPLATE(BM_ClearRefillBatch, std::deque<T>)->Range(1 << 6, 1 << 14);        \
+  BENCHMARK_TEMPLATE(BM_ConstructEmpty, deque::Deque<T>);                                \
+  BENCHMARK_TEMPLATE(BM_ConstructEmpty, std::deque<T>)
+
+DEQUE_COPY_CLEAR_BENCH(int);
+DEQUE_COPY_CLEAR_BENCH(Quote);
+DEQUE_COPY_CLEAR_BENCH(std::string);
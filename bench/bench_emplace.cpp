@@ -0,0 +1,101 @@
+// 原地构造：emplaceBack/emplaceFront 与先构造临时对象再 pushBack 的对比
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+// 128 字节的消息结构，带一个自有缓冲区
+struct Message {
+  Message(long long seq, const char* topic, std::size_t payload_size)
+      : sequence(seq), payload(new char[payload_size]), payload_size(payload_size) {
+    std::strncpy(topic_name, topic, sizeof(topic_name) - 1);
+    topic_name[sizeof(topic_name) - 1] = '\0';
+    std::memset(payload.get(), 0, payload_size);
+  }
+
+  Message(Message&&) noexcept = default;
+  Message& operator=(Message&&) noexcept = default;
+
+  long long sequence;
+  std::unique_ptr<char[]> payload;
+  std::size_t payload_size;
+  char topic_name[104];
+};
+
+static_assert(sizeof(Message) == 128, "Message is expected to be 128 bytes");
+
+const char* const kLongText = "a string that is long enough to defeat the small string optimization";
+
+}  // namespace
+
+static void BM_PushBackTemporaryString(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<std::string> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.pushBack(std::string(kLongText, 40 + i % 16));
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_EmplaceBackString(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<std::string> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.emplaceBack(kLongText, 40 + i % 16);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PushBackTemporaryMessage(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<Message> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.pushBack(Message(static_cast<long long>(i), "orders", 64));
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_EmplaceBackMessage(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<Message> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.emplaceBack(static_cast<long long>(i), "orders", 64);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_EmplaceFrontMessage(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<Message> d;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.emplaceFront(static_cast<long long>(i), "orders", 64);
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PushBackTemporaryString)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBackString)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PushBackTemporaryMessage)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBackMessage)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceFrontMessage)->Range(1 << 10, 1 << 18);
@@ -0,0 +1,84 @@
+// 超大容器：10^9 个元素上的随机访问与顺序扫描，比较
+// 默认块 + std::allocator、大页尺寸块 + std::allocator 与 HugePageDeque（大页尺寸块 + mmap/MADV_HUGEPAGE）。
+// 元素取 1 字节，10^9 个元素约 1 GB，单机内存放得下；跨度已足以让 TLB 成为瓶颈。
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "deque/deque.hpp"
+#include "deque/hugepage_allocator.hpp"
+
+namespace {
+
+using Byte = std::uint8_t;
+
+constexpr std::size_t kElements = 1000000000;
+constexpr std::size_t kRandomReads = 10000000;
+
+using DefaultDeque = deque::Deque<Byte>;
+using LargeBlockDeque = deque::Deque<Byte, std::allocator<Byte>, deque::hugePageBlockSize<Byte>()>;
+using HugePageDeque = deque::HugePageDeque<Byte>;
+
+template <class Container>
+void fill(Container& c) {
+  c.resize(kElements);
+  std::size_t i = 0;
+  for (auto segment : c.segments()) {
+    for (Byte& value : segment) {
+      value = static_cast<Byte>(i++);
+    }
+  }
+}
+
+// xorshift 生成索引，低 32 位乘 n 取高位映射到 [0, n)（n < 2^32），循环里没有额外的内存访问。
+struct IndexGenerator {
+  std::uint64_t state = 88172645463325252ULL;
+  std::size_t next(std::size_t n) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<std::size_t>(((state & 0xffffffffULL) * n) >> 32);
+  }
+};
+
+}  // namespace
+
+template <class Container>
+static void BM_HugeRandomAccess(benchmark::State& state) {
+  Container c;
+  fill(c);
+  IndexGenerator indices;
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kRandomReads; ++i) {
+      sum += c[indices.next(kElements)];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kRandomReads));
+}
+
+template <class Container>
+static void BM_HugeSequentialScan(benchmark::State& state) {
+  Container c;
+  fill(c);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto segment : c.segments()) {
+      for (Byte value : segment) {
+        sum += value;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kElements));
+}
+
+BENCHMARK_TEMPLATE(BM_HugeRandomAccess, DefaultDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_HugeRandomAccess, LargeBlockDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_HugeRandomAccess, HugePageDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_HugeSequentialScan, DefaultDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_HugeSequentialScan, LargeBlockDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_HugeSequentialScan, HugePageDeque)->Unit(benchmark::kMillisecond)->Iterations(3);
@@ -0,0 +1,49 @@
+// 中间插入/删除：靠近前端的操作只移动较短的一侧
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+
+template <class Container>
+static void BM_InsertEraseAt(benchmark::State& state) {
+  // range(0)：容器大小；range(1)：插入位置占容器大小的百分比
+  auto size = static_cast<std::size_t>(state.range(0));
+  auto c = bench::makeFilled<Container>(size);
+  auto index = static_cast<std::ptrdiff_t>(size * static_cast<std::size_t>(state.range(1)) / 100);
+  for (auto _ : state) {
+    auto it = c.insert(c.begin() + index, 42);
+    benchmark::DoNotOptimize(&*it);
+    c.erase(c.begin() + index);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <class Container>
+static void BM_EraseRangeNearFront(benchmark::State& state) {
+  auto size = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = bench::makeFilled<Container>(size);
+    state.ResumeTiming();
+    auto first = static_cast<std::ptrdiff_t>(size / 16);
+    c.erase(c.begin() + first, c.begin() + first * 2);
+    benchmark::DoNotOptimize(c.size());
+  }
+}
+
+static void insertEraseArgs(benchmark::internal::Benchmark* b) {
+  for (long size : {1L << 10, 1L << 14, 1L << 18, 1L << 20}) {
+    for (long percent : {1L, 10L, 50L, 90L, 99L}) {
+      b->Args({size, percent});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_InsertEraseAt, deque::Deque<int>)->Apply(insertEraseArgs);
+BENCHMARK_TEMPLATE(BM_InsertEraseAt, std::deque<int>)->Apply(insertEraseArgs);
+
+BENCHMARK_TEMPLATE(BM_EraseRangeNearFront, deque::Deque<int>)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_EraseRangeNearFront, std::deque<int>)->Range(1 << 12, 1 << 20);
@@ -0,0 +1,138 @@
+// 映射数组增长策略：10^8 个元素的只推尾、只推头、两端混合与 FIFO 负载，
+// 比较居中/偏向热端以及不同增长倍数下的耗时、映射数组分配次数与原地搬移次数。
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+using Deque = deque::Deque<std::int32_t>;
+using Policy = Deque::map_growth_policy;
+
+constexpr std::size_t kElements = 100000000;
+
+enum PolicyKind : int { kBiased, kCentered, kBiasedFactor1_5, kBiasedFactor4, kNoRecenter };
+
+Policy makePolicy(int kind) {
+  Policy policy;
+  switch (kind) {
+    case kCentered:
+      policy.bias_to_hot_end = false;
+      break;
+    case kBiasedFactor1_5:
+      policy.growth_factor = 1.5;
+      break;
+    case kBiasedFactor4:
+      policy.growth_factor = 4.0;
+      break;
+    case kNoRecenter:
+      policy.recenter_in_place = false;
+      break;
+    default:
+      break;
+  }
+  return policy;
+}
+
+const char* policyName(int kind) {
+  switch (kind) {
+    case kCentered:
+      return "centered";
+    case kBiasedFactor1_5:
+      return "biased/x1.5";
+    case kBiasedFactor4:
+      return "biased/x4";
+    case kNoRecenter:
+      return "biased/no-recenter";
+    default:
+      return "biased";
+  }
+}
+
+void policies(benchmark::internal::Benchmark* b) {
+  for (int kind : {kBiased, kCentered, kBiasedFactor1_5, kBiasedFactor4, kNoRecenter}) {
+    b->Arg(kind);
+  }
+  b->Iterations(1)->Unit(benchmark::kMillisecond);
+}
+
+void reportMapStats(benchmark::State& state, const Deque& d) {
+  auto stats = d.blockStats();
+  state.SetLabel(policyName(static_cast<int>(state.range(0))));
+  state.counters["map_allocations"] = static_cast<double>(stats.map_allocations);
+  state.counters["map_recenters"] = static_cast<double>(stats.map_recenters);
+}
+
+}  // namespace
+
+static void BM_MapGrowthBackOnly(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d;
+    d.setMapGrowthPolicy(makePolicy(static_cast<int>(state.range(0))));
+    for (std::size_t i = 0; i < kElements; ++i) {
+      d.pushBack(static_cast<std::int32_t>(i));
+    }
+    benchmark::DoNotOptimize(d.size());
+    reportMapStats(state, d);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kElements));
+}
+
+static void BM_MapGrowthFrontOnly(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d;
+    d.setMapGrowthPolicy(makePolicy(static_cast<int>(state.range(0))));
+    for (std::size_t i = 0; i < kElements; ++i) {
+      d.pushFront(static_cast<std::int32_t>(i));
+    }
+    benchmark::DoNotOptimize(d.size());
+    reportMapStats(state, d);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kElements));
+}
+
+// 两端混合：四分之三推尾、四分之一推头。
+static void BM_MapGrowthMixed(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d;
+    d.setMapGrowthPolicy(makePolicy(static_cast<int>(state.range(0))));
+    std::mt19937 rng(3);
+    for (std::size_t i = 0; i < kElements; ++i) {
+      if ((rng() & 3) != 0) {
+        d.pushBack(static_cast<std::int32_t>(i));
+      } else {
+        d.pushFront(static_cast<std::int32_t>(i));
+      }
+    }
+    benchmark::DoNotOptimize(d.size());
+    reportMapStats(state, d);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kElements));
+}
+
+// 推尾弹头 10^8 次，队列长度保持在 2^16：映射数组不再增长，只剩原地搬移。
+static void BM_MapGrowthFifo(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d;
+    d.setMapGrowthPolicy(makePolicy(static_cast<int>(state.range(0))));
+    for (std::int32_t i = 0; i < (1 << 16); ++i) {
+      d.pushBack(i);
+    }
+    for (std::size_t i = 0; i < kElements; ++i) {
+      d.pushBack(static_cast<std::int32_t>(i));
+      d.popFront();
+    }
+    benchmark::DoNotOptimize(d.size());
+    reportMapStats(state, d);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kElements));
+}
+
+BENCHMARK(BM_MapGrowthBackOnly)->Apply(policies);
+BENCHMARK(BM_MapGrowthFrontOnly)->Apply(policies);
+BENCHMARK(BM_MapGrowthMixed)->Apply(policies);
+BENCHMARK(BM_MapGrowthFifo)->Apply(policies);
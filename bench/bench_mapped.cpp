@@ -0,0 +1,159 @@
+// 文件映射的持久化队列 MappedDeque：推入、FIFO 稳态、随机读取与重新打开的开销，
+// 以内存中的 deque::Deque 作对照。重新打开按文件中的元素数扫描，耗时应与规模无关。
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+#include "deque/mapped_deque.hpp"
+
+namespace {
+
+using Mapped = deque::MappedDeque<std::uint64_t>;
+
+std::string benchPath(const char* name) {
+  const char* dir = std::getenv("TMPDIR");
+  return std::string(dir != nullptr ? dir : "/tmp") + "/deque_bench_" + name + "_" + std::to_string(::getpid()) +
+         ".map";
+}
+
+// 每个基准用一个新文件，结束时删除。
+struct ScratchFile {
+  explicit ScratchFile(const char* name) : path(benchPath(name)) { std::remove(path.c_str()); }
+  ~ScratchFile() { std::remove(path.c_str()); }
+  std::string path;
+};
+
+}  // namespace
+
+namespace bench {
+
+template <class T, std::size_t B>
+inline void pushBack(deque::MappedDeque<T, B>& c, const T& v) { c.pushBack(v); }
+template <class T, std::size_t B>
+inline void popFront(deque::MappedDeque<T, B>& c) { c.popFront(); }
+
+}  // namespace bench
+
+static void BM_MappedPushBack(benchmark::State& state) {
+  ScratchFile file("push");
+  const auto n = static_cast<std::uint64_t>(state.range(0));
+  Mapped c(file.path);
+  for (auto _ : state) {
+    for (std::uint64_t i = 0; i < n; ++i) {
+      c.pushBack(i);
+    }
+    state.PauseTiming();
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DequePushBack(benchmark::State& state) {
+  const auto n = static_cast<std::uint64_t>(state.range(0));
+  deque::Deque<std::uint64_t> c;
+  for (auto _ : state) {
+    for (std::uint64_t i = 0; i < n; ++i) {
+      c.pushBack(i);
+    }
+    state.PauseTiming();
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void runFifo(benchmark::State& state, Container& c) {
+  for (std::uint64_t i = 0; i < static_cast<std::uint64_t>(state.range(0)); ++i) {
+    bench::pushBack(c, i);
+  }
+  std::uint64_t next = 0;
+  for (auto _ : state) {
+    bench::pushBack(c, next++);
+    bench::popFront(c);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MappedFifo(benchmark::State& state) {
+  ScratchFile file("fifo");
+  Mapped c(file.path);
+  runFifo(state, c);
+  state.counters["file_mib"] = static_cast<double>(c.fileBytes()) / (1 << 20);
+}
+
+static void BM_DequeFifo(benchmark::State& state) {
+  deque::Deque<std::uint64_t> c;
+  runFifo(state, c);
+}
+
+static void BM_MappedRandomRead(benchmark::State& state) {
+  ScratchFile file("read");
+  const auto n = static_cast<std::size_t>(state.range(0));
+  Mapped c(file.path);
+  for (std::uint64_t i = 0; i < n; ++i) {
+    c.pushBack(i);
+  }
+  std::mt19937_64 rng(42);
+  std::vector<std::size_t> indices(1 << 16);
+  for (auto& index : indices) {
+    index = rng() % n;
+  }
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += c[index];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+
+// 重新打开只读取固定的文件头，与文件中的元素数无关。
+static void BM_MappedReopen(benchmark::State& state) {
+  ScratchFile file("reopen");
+  {
+    Mapped c(file.path);
+    for (std::uint64_t i = 0; i < static_cast<std::uint64_t>(state.range(0)); ++i) {
+      c.pushBack(i);
+    }
+  }
+  for (auto _ : state) {
+    Mapped c(file.path);
+    benchmark::DoNotOptimize(c.back());
+  }
+}
+
+static void BM_MappedSync(benchmark::State& state) {
+  ScratchFile file("sync");
+  Mapped c(file.path);
+  const auto mode = state.range(0) == 0 ? deque::SyncMode::blocking : deque::SyncMode::async;
+  std::uint64_t next = 0;
+  for (auto _ : state) {
+    // 每次同步前修改一页左右的数据
+    for (int i = 0; i < 512; ++i) {
+      c.pushBack(next++);
+    }
+    c.sync(mode);
+  }
+  state.SetItemsProcessed(state.iterations() * 512);
+}
+
+BENCHMARK(BM_MappedPushBack)->Arg(1 << 20);
+BENCHMARK(BM_DequePushBack)->Arg(1 << 20);
+BENCHMARK(BM_MappedFifo)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_DequeFifo)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_MappedRandomRead)->Arg(1 << 20);
+BENCHMARK(BM_MappedReopen)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK(BM_MappedSync)->Arg(0)->Arg(1);
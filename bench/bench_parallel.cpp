@@ -0,0 +1,115 @@
+// 并行算法扩展性：10^7 个元素上的 reduce / transform / sort，线程数 1..硬件线程数，
+// 以单线程的分段算法与 std::sort 作为基线
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "deque/algorithm.hpp"
+#include "deque/deque.hpp"
+#include "deque/parallel.hpp"
+
+namespace {
+
+constexpr std::size_t parallel_count = 10'000'000;
+
+const deque::Deque<double>& doubleInput() {
+  static const deque::Deque<double> input = bench::makeFilled<deque::Deque<double>>(parallel_count);
+  return input;
+}
+
+const std::vector<std::uint64_t>& shuffledKeys() {
+  static const std::vector<std::uint64_t> keys = [] {
+    std::vector<std::uint64_t> v(parallel_count);
+    std::mt19937_64 rng(42);
+    for (auto& key : v) {
+      key = rng();
+    }
+    return v;
+  }();
+  return keys;
+}
+
+void fillKeys(deque::Deque<std::uint64_t>& d) {
+  const auto& keys = shuffledKeys();
+  std::copy(keys.begin(), keys.end(), d.begin());
+}
+
+}  // namespace
+
+static void BM_ParallelReduce(benchmark::State& state) {
+  const auto& c = doubleInput();
+  deque::parallel::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = deque::parallel::reduce(pool, c.begin(), c.end(), 0.0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(parallel_count));
+}
+
+static void BM_ParallelTransform(benchmark::State& state) {
+  const auto& c = doubleInput();
+  deque::Deque<double> out;
+  out.resize(parallel_count);
+  deque::parallel::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    deque::parallel::transform(pool, c.begin(), c.end(), out.begin(), [](double value) { return value * 1.5 + 1.0; });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(parallel_count));
+}
+
+static void BM_ParallelSort(benchmark::State& state) {
+  deque::Deque<std::uint64_t> d;
+  d.resize(parallel_count);
+  deque::parallel::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillKeys(d);
+    state.ResumeTiming();
+    deque::parallel::sort(pool, d.begin(), d.end());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(parallel_count));
+}
+
+static void BM_SequentialSort(benchmark::State& state) {
+  deque::Deque<std::uint64_t> d;
+  d.resize(parallel_count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillKeys(d);
+    state.ResumeTiming();
+    std::sort(d.begin(), d.end());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(parallel_count));
+}
+
+static void BM_SequentialReduce(benchmark::State& state) {
+  const auto& c = doubleInput();
+  for (auto _ : state) {
+    double sum = deque::accumulate(c.begin(), c.end(), 0.0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(parallel_count));
+}
+
+// 线程数按 2 的幂递增，最后补上硬件线程数本身
+static void threadArgs(benchmark::internal::Benchmark* b) {
+  const long hardware = std::max(1L, static_cast<long>(std::thread::hardware_concurrency()));
+  for (long threads = 1; threads < hardware; threads *= 2) {
+    b->Arg(threads);
+  }
+  b->Arg(hardware);
+  b->ArgNames({"threads"});
+}
+
+BENCHMARK(BM_ParallelReduce)->Apply(threadArgs)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SequentialReduce)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelTransform)->Apply(threadArgs)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelSort)->Apply(threadArgs)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SequentialSort)->Unit(benchmark::kMillisecond);
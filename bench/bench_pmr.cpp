@@ -0,0 +1,88 @@
+// 每个请求一个临时 Deque：std::allocator 与 pmr 单调/池资源的对比
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+// 模拟一次请求：写入 count 个元素，两端各取一半，最后整体遍历
+template <class D>
+long long scratchWork(D& d, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 4 == 0) {
+      d.pushFront(static_cast<long long>(i));
+    } else {
+      d.pushBack(static_cast<long long>(i));
+    }
+  }
+  long long sum = 0;
+  for (long long v : d) {
+    sum += v;
+  }
+  return sum;
+}
+
+}  // namespace
+
+static void BM_ScratchStdAllocator(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    deque::Deque<long long> d;
+    benchmark::DoNotOptimize(scratchWork(d, count));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ScratchMonotonic(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  std::vector<std::byte> buffer(count * sizeof(long long) * 4 + (1 << 16));
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    deque::pmr::Deque<long long> d(&arena);
+    benchmark::DoNotOptimize(scratchWork(d, count));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ScratchUnsynchronizedPool(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  std::pmr::unsynchronized_pool_resource pool;
+  for (auto _ : state) {
+    deque::pmr::Deque<long long> d(&pool);
+    benchmark::DoNotOptimize(scratchWork(d, count));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 单调资源上批量创建多个小 Deque（典型的每请求暂存队列）
+static void BM_ManySmallDequesStd(benchmark::State& state) {
+  for (auto _ : state) {
+    for (int i = 0; i < 64; ++i) {
+      deque::Deque<long long> d;
+      benchmark::DoNotOptimize(scratchWork(d, 16));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+
+static void BM_ManySmallDequesMonotonic(benchmark::State& state) {
+  std::vector<std::byte> buffer(1 << 20);
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    for (int i = 0; i < 64; ++i) {
+      deque::pmr::Deque<long long> d(&arena);
+      benchmark::DoNotOptimize(scratchWork(d, 16));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+
+BENCHMARK(BM_ScratchStdAllocator)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_ScratchMonotonic)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_ScratchUnsynchronizedPool)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_ManySmallDequesStd);
+BENCHMARK(BM_ManySmallDequesMonotonic);
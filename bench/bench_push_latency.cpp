@@ -0,0 +1,137 @@
+// 推入尾延迟：逐次计时 2^24 次 pushBack / pushFront / FIFO 推尾弹头，按 2 的幂分桶统计单次耗时，
+// 比较一次性重新分配映射数组与增量增长（MapGrowthPolicy::incremental）下的 p50 / p99 / p99.9 / p99.99 / 最大值。
+// 小块（64 个元素）放大映射数组的大小，使一次性复制全部块指针的停顿更明显。
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+using Deque = deque::Deque<std::uint64_t, std::allocator<std::uint64_t>, 64>;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kOperations = std::size_t{1} << 24;
+
+// 第 k 个桶统计耗时落在 [2^k, 2^(k+1)) 纳秒的操作数，第 0 个桶包含 0 纳秒。
+class LatencyHistogram {
+ public:
+  void record(std::uint64_t nanos) {
+    std::size_t bucket = 0;
+    while (bucket + 1 < buckets_.size() && (nanos >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+    ++buckets_[bucket];
+    ++count_;
+    max_ = nanos > max_ ? nanos : max_;
+  }
+
+  // 返回分位点所在桶的上界（纳秒）。
+  double percentile(double fraction) const {
+    auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count_));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < buckets_.size(); ++bucket) {
+      seen += buckets_[bucket];
+      if (seen > rank) {
+        return static_cast<double>(std::uint64_t{1} << (bucket + 1));
+      }
+    }
+    return static_cast<double>(max_);
+  }
+
+  void report(benchmark::State& state) const {
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p99.9_ns"] = percentile(0.999);
+    state.counters["p99.99_ns"] = percentile(0.9999);
+    state.counters["max_ns"] = static_cast<double>(max_);
+    // 1 微秒以上的慢操作逐桶列出
+    for (std::size_t bucket = 10; bucket < buckets_.size(); ++bucket) {
+      if (buckets_[bucket] != 0) {
+        state.counters["ge_" + std::to_string(std::uint64_t{1} << bucket) + "ns"] =
+            static_cast<double>(buckets_[bucket]);
+      }
+    }
+  }
+
+ private:
+  std::array<std::uint64_t, 40> buckets_{};
+  std::uint64_t count_ = 0;
+  std::uint64_t max_ = 0;
+};
+
+Deque makeDeque(benchmark::State& state) {
+  Deque d;
+  Deque::map_growth_policy policy;
+  policy.incremental = state.range(0) != 0;
+  d.setMapGrowthPolicy(policy);
+  state.SetLabel(policy.incremental ? "incremental" : "reallocate");
+  return d;
+}
+
+template <class Op>
+void timeEach(benchmark::State& state, Deque& d, LatencyHistogram& histogram, Op op) {
+  for (std::size_t i = 0; i < kOperations; ++i) {
+    auto begin = Clock::now();
+    op(d, static_cast<std::uint64_t>(i));
+    auto end = Clock::now();
+    histogram.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+  }
+  benchmark::DoNotOptimize(d.size());
+  auto stats = d.blockStats();
+  state.counters["map_allocations"] = static_cast<double>(stats.map_allocations);
+  state.counters["map_migrations"] = static_cast<double>(stats.map_migrations);
+  state.counters["map_recenters"] = static_cast<double>(stats.map_recenters);
+}
+
+void policies(benchmark::internal::Benchmark* b) {
+  b->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+static void BM_PushBackLatency(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d = makeDeque(state);
+    LatencyHistogram histogram;
+    timeEach(state, d, histogram, [](Deque& c, std::uint64_t v) { c.pushBack(v); });
+    histogram.report(state);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kOperations));
+}
+
+static void BM_PushFrontLatency(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d = makeDeque(state);
+    LatencyHistogram histogram;
+    timeEach(state, d, histogram, [](Deque& c, std::uint64_t v) { c.pushFront(v); });
+    histogram.report(state);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kOperations));
+}
+
+// 队列长度保持在 2^20：映射数组不再增长，一次性模式下只剩原地搬移的停顿。
+static void BM_FifoLatency(benchmark::State& state) {
+  for (auto _ : state) {
+    Deque d = makeDeque(state);
+    for (std::uint64_t i = 0; i < (std::uint64_t{1} << 20); ++i) {
+      d.pushBack(i);
+    }
+    LatencyHistogram histogram;
+    timeEach(state, d, histogram, [](Deque& c, std::uint64_t v) {
+      c.pushBack(v);
+      c.popFront();
+    });
+    histogram.report(state);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kOperations));
+}
+
+BENCHMARK(BM_PushBackLatency)->Apply(policies);
+BENCHMARK(BM_PushFrontLatency)->Apply(policies);
+BENCHMARK(BM_FifoLatency)->Apply(policies);
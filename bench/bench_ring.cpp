@@ -0,0 +1,104 @@
+// 滑动窗口（保留最近 N 个 tick）：RingDeque / DynamicRingDeque 的覆盖写入
+// 与 Deque、std::deque 的“尾进头出”对比；另测窗口内按下标的随机读取
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+#include "deque/ring_deque.hpp"
+
+namespace {
+
+constexpr std::size_t ticks_per_iteration = 1 << 16;
+
+template <std::size_t N>
+struct StaticWindow {
+  deque::RingDeque<double, N> ring{deque::OverflowPolicy::overwrite};
+  void push(double tick) { ring.pushBack(tick); }
+  double at(std::size_t i) const { return ring[i]; }
+  std::size_t size() const { return ring.size(); }
+};
+
+template <std::size_t N>
+struct DynamicWindow {
+  deque::DynamicRingDeque<double> ring{N, deque::OverflowPolicy::overwrite};
+  void push(double tick) { ring.pushBack(tick); }
+  double at(std::size_t i) const { return ring[i]; }
+  std::size_t size() const { return ring.size(); }
+};
+
+template <std::size_t N, class Container>
+struct QueueWindow {
+  Container queue;
+  void push(double tick) {
+    if (queue.size() == N) {
+      bench::popFront(queue);
+    }
+    bench::pushBack(queue, tick);
+  }
+  double at(std::size_t i) const { return queue[i]; }
+  std::size_t size() const { return queue.size(); }
+};
+
+template <std::size_t N>
+using DequeWindow = QueueWindow<N, deque::Deque<double>>;
+
+template <std::size_t N>
+using StdDequeWindow = QueueWindow<N, std::deque<double>>;
+
+}  // namespace
+
+// 每个 tick 进入窗口，同时读取首尾（例如计算区间涨跌）。
+template <class Window>
+static void BM_WindowPush(benchmark::State& state) {
+  Window window;
+  double tick = 0.0;
+  for (auto _ : state) {
+    double spread = 0.0;
+    for (std::size_t i = 0; i < ticks_per_iteration; ++i) {
+      window.push(tick);
+      tick += 1.0;
+      spread += window.at(window.size() - 1) - window.at(0);
+    }
+    benchmark::DoNotOptimize(spread);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(ticks_per_iteration));
+}
+
+// 窗口已满后按随机下标读取。
+template <class Window>
+static void BM_WindowRandomRead(benchmark::State& state) {
+  Window window;
+  for (std::size_t i = 0; i < 3 * ticks_per_iteration; ++i) {
+    window.push(static_cast<double>(i));
+  }
+  std::mt19937 rng(5);
+  std::vector<std::size_t> indices(ticks_per_iteration);
+  for (auto& index : indices) {
+    index = rng() % window.size();
+  }
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t index : indices) {
+      sum += window.at(index);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(ticks_per_iteration));
+}
+
+#define DEQUE_RING_WINDOWS(BM, N)                 \
+  BENCHMARK_TEMPLATE(BM, StaticWindow<N>);   \
+  BENCHMARK_TEMPLATE(BM, DynamicWindow<N>);  \
+  BENCHMARK_TEMPLATE(BM, DequeWindow<N>);    \
+  BENCHMARK_TEMPLATE(BM, StdDequeWindow<N>)
+
+DEQUE_RING_WINDOWS(BM_WindowPush, 64);
+DEQUE_RING_WINDOWS(BM_WindowPush, 1000);
+DEQUE_RING_WINDOWS(BM_WindowPush, 16384);
+DEQUE_RING_WINDOWS(BM_WindowRandomRead, 1000);
+DEQUE_RING_WINDOWS(BM_WindowRandomRead, 16384);
@@ -0,0 +1,76 @@
+// 分段视图：对 10^7 个 double 求和，比较逐元素下标、迭代器与按块 segments() 遍历
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <numeric>
+
+#include "bench_common.hpp"
+#include "deque/algorithm.hpp"
+#include "deque/deque.hpp"
+
+namespace {
+
+constexpr std::size_t reduce_count = 10'000'000;
+
+template <class Container>
+const Container& reduceInput() {
+  static const Container input = bench::makeFilled<Container>(reduce_count);
+  return input;
+}
+
+}  // namespace
+
+template <class Container>
+static void BM_ReduceIndex(benchmark::State& state) {
+  const auto& c = reduceInput<Container>();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < c.size(); ++i) {
+      sum += c[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(reduce_count));
+}
+
+template <class Container>
+static void BM_ReduceIterator(benchmark::State& state) {
+  const auto& c = reduceInput<Container>();
+  for (auto _ : state) {
+    double sum = std::accumulate(c.begin(), c.end(), 0.0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(reduce_count));
+}
+
+static void BM_ReduceSegments(benchmark::State& state) {
+  const auto& c = reduceInput<deque::Deque<double>>();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (auto segment : c.segments()) {
+      const double* data = segment.data();
+      for (std::size_t i = 0; i < segment.size(); ++i) {
+        sum += data[i];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(reduce_count));
+}
+
+static void BM_ReduceSegmentedAccumulate(benchmark::State& state) {
+  const auto& c = reduceInput<deque::Deque<double>>();
+  for (auto _ : state) {
+    double sum = deque::accumulate(c.begin(), c.end(), 0.0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(reduce_count));
+}
+
+BENCHMARK_TEMPLATE(BM_ReduceIndex, deque::Deque<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReduceIndex, std::deque<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReduceIterator, deque::Deque<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReduceIterator, std::deque<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReduceSegments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReduceSegmentedAccumulate)->Unit(benchmark::kMillisecond);
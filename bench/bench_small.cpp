@@ -0,0 +1,38 @@
+// 大量短生命周期的小队列（例如每个连接的待发送队列）：构造、推入少量元素、取空、析构
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+#include "deque/small_deque.hpp"
+
+namespace bench {
+
+template <class T, std::size_t N, class A, std::size_t B>
+inline void pushBack(deque::SmallDeque<T, N, A, B>& c, const T& v) { c.pushBack(v); }
+template <class T, std::size_t N, class A, std::size_t B>
+inline void popFront(deque::SmallDeque<T, N, A, B>& c) { c.popFront(); }
+
+}  // namespace bench
+
+template <class Container>
+static void BM_ShortLivedQueue(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Container c;
+    for (std::size_t i = 0; i < count; ++i) {
+      bench::pushBack(c, static_cast<int>(i));
+    }
+    while (!c.empty()) {
+      bench::popFront(c);
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, deque::SmallDeque<int, 8>)->Arg(0)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, deque::Deque<int>)->Arg(0)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK_TEMPLATE(BM_ShortLivedQueue, std::deque<int>)->Arg(0)->Arg(2)->Arg(8)->Arg(32);
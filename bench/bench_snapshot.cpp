@@ -0,0 +1,55 @@
+// 快照：每轮取一次一致快照再做少量修改（改一个元素、两端各推入/弹出一个），
+// SnapshotDeque 的写时复制快照与 Deque 完整拷贝对比，元素为 32 字节
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+#include "deque/snapshot_deque.hpp"
+
+namespace {
+
+using Order = bench::Blob<32>;
+
+template <class Container>
+void mutateLittle(Container& c, std::uint64_t tick) {
+  c[c.size() / 2] = Order(tick);
+  c.pushBack(Order(tick));
+  c.popFront();
+}
+
+}  // namespace
+
+static void BM_FullCopy(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  auto book = bench::makeFilled<deque::Deque<Order>>(count);
+  std::uint64_t tick = 0;
+  for (auto _ : state) {
+    deque::Deque<Order> copy(book);
+    benchmark::DoNotOptimize(copy.back());
+    mutateLittle(book, ++tick);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_CowSnapshot(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  deque::SnapshotDeque<Order> book;
+  for (std::size_t i = 0; i < count; ++i) {
+    book.pushBack(Order(i));
+  }
+  std::uint64_t tick = 0;
+  for (auto _ : state) {
+    auto snap = book.snapshot();
+    benchmark::DoNotOptimize(snap.back());
+    // 快照仍存活时修改：被写到的块按需复制
+    mutateLittle(book, ++tick);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FullCopy)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CowSnapshot)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond);
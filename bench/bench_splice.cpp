@@ -0,0 +1,86 @@
+// 拆分与拼接：把 10^6 个元素的前 k 个移到另一个 Deque 再移回，
+// 按块转移所有权（splitAt + appendSplice/prependSplice）与逐个 popFront/pushBack 的对比
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+
+namespace {
+
+constexpr std::size_t splice_count = 1'000'000;
+
+using Container = deque::Deque<std::uint64_t>;
+
+}  // namespace
+
+static void BM_MoveFrontLoop(benchmark::State& state) {
+  const auto k = static_cast<std::size_t>(state.range(0));
+  Container source = bench::makeFilled<Container>(splice_count);
+  Container batch;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < k; ++i) {
+      batch.pushBack(source.front());
+      source.popFront();
+    }
+    // 移回原处，保持每轮的初始状态一致
+    while (!batch.empty()) {
+      source.pushFront(batch.back());
+      batch.popBack();
+    }
+    benchmark::DoNotOptimize(source.front());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(k) * 2);
+}
+
+static void BM_MoveFrontSplice(benchmark::State& state) {
+  const auto k = static_cast<std::size_t>(state.range(0));
+  Container source = bench::makeFilled<Container>(splice_count);
+  Container batch;
+  for (auto _ : state) {
+    Container rest = source.splitAt(k);
+    batch.appendSplice(std::move(source));
+    source = std::move(rest);
+    source.prependSplice(std::move(batch));
+    benchmark::DoNotOptimize(source.front());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(k) * 2);
+}
+
+// 两个各 n/2 个元素的 Deque 合并后再从中间拆开
+static void BM_ConcatenateLoop(benchmark::State& state) {
+  Container left = bench::makeFilled<Container>(splice_count / 2);
+  Container right = bench::makeFilled<Container>(splice_count / 2);
+  for (auto _ : state) {
+    while (!right.empty()) {
+      left.pushBack(right.front());
+      right.popFront();
+    }
+    while (left.size() > splice_count / 2) {
+      right.pushFront(left.back());
+      left.popBack();
+    }
+    benchmark::DoNotOptimize(left.back());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(splice_count));
+}
+
+static void BM_ConcatenateSplice(benchmark::State& state) {
+  Container left = bench::makeFilled<Container>(splice_count / 2);
+  Container right = bench::makeFilled<Container>(splice_count / 2);
+  // 只有第一次合并时两边块内偏移可能不一致；之后 splitAt 保留偏移，每轮都按块转移
+  for (auto _ : state) {
+    left.appendSplice(std::move(right));
+    right = left.splitAt(splice_count / 2);
+    benchmark::DoNotOptimize(left.back());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(splice_count));
+}
+
+BENCHMARK(BM_MoveFrontLoop)->RangeMultiplier(16)->Range(1 << 8, 1 << 18)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MoveFrontSplice)->RangeMultiplier(16)->Range(1 << 8, 1 << 18)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcatenateLoop)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcatenateSplice)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,165 @@
+// 两线程生产者/消费者：SpscDeque 与互斥锁包装的 Deque 的吞吐与往返延迟
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "deque/deque.hpp"
+#include "deque/detail/concurrent.hpp"
+#include "deque/spsc_deque.hpp"
+
+namespace {
+
+constexpr std::size_t transfer_count = 1 << 16;
+constexpr std::size_t batch_size = 64;
+
+// 与 SpscDeque 接口一致的基线：每个操作持有一次互斥锁。
+template <class T>
+class MutexDeque {
+ public:
+  bool tryPushBack(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deque_.pushBack(value);
+    return true;
+  }
+
+  bool tryPopFront(T& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) {
+      return false;
+    }
+    out = std::move(deque_.front());
+    deque_.popFront();
+    return true;
+  }
+
+  template <class ForwardIt>
+  std::size_t tryPushBulk(ForwardIt first, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < count; ++i, ++first) {
+      deque_.pushBack(*first);
+    }
+    return count;
+  }
+
+  template <class OutputIt>
+  std::size_t tryPopBulk(OutputIt out, std::size_t max_count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t n = 0;
+    for (; n < max_count && !deque_.empty(); ++n, ++out) {
+      *out = std::move(deque_.front());
+      deque_.popFront();
+    }
+    return n;
+  }
+
+ private:
+  std::mutex mutex_;
+  deque::Deque<T> deque_;
+};
+
+}  // namespace
+
+template <class Queue>
+static void BM_SpscThroughput(benchmark::State& state) {
+  Queue queue;
+  for (auto _ : state) {
+    std::thread producer([&queue] {
+      deque::detail::Backoff backoff;
+      for (std::size_t i = 0; i < transfer_count;) {
+        if (queue.tryPushBack(static_cast<long long>(i))) {
+          ++i;
+          backoff.reset();
+        } else {
+          backoff.pause();
+        }
+      }
+    });
+    deque::detail::Backoff backoff;
+    long long value = 0;
+    long long sum = 0;
+    for (std::size_t received = 0; received < transfer_count;) {
+      if (queue.tryPopFront(value)) {
+        sum += value;
+        ++received;
+        backoff.reset();
+      } else {
+        backoff.pause();
+      }
+    }
+    producer.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(transfer_count));
+}
+
+template <class Queue>
+static void BM_SpscThroughputBulk(benchmark::State& state) {
+  Queue queue;
+  std::vector<long long> input(batch_size);
+  for (auto _ : state) {
+    std::thread producer([&queue, &input] {
+      deque::detail::Backoff backoff;
+      for (std::size_t i = 0; i < transfer_count;) {
+        std::size_t pushed = queue.tryPushBulk(input.begin(), std::min(batch_size, transfer_count - i));
+        i += pushed;
+        pushed == 0 ? backoff.pause() : backoff.reset();
+      }
+    });
+    deque::detail::Backoff backoff;
+    std::vector<long long> output(batch_size);
+    for (std::size_t received = 0; received < transfer_count;) {
+      std::size_t popped = queue.tryPopBulk(output.begin(), batch_size);
+      received += popped;
+      popped == 0 ? backoff.pause() : backoff.reset();
+    }
+    producer.join();
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(transfer_count));
+}
+
+// 两个队列之间来回传递一个值，单次往返时间即端到端延迟的两倍。
+template <class Queue>
+static void BM_SpscPingPong(benchmark::State& state) {
+  constexpr std::size_t round_trips = 1 << 12;
+  Queue ping;
+  Queue pong;
+  for (auto _ : state) {
+    std::thread echo([&ping, &pong] {
+      deque::detail::Backoff backoff;
+      long long value = 0;
+      for (std::size_t i = 0; i < round_trips;) {
+        if (ping.tryPopFront(value)) {
+          pong.tryPushBack(value);
+          ++i;
+          backoff.reset();
+        } else {
+          backoff.pause();
+        }
+      }
+    });
+    deque::detail::Backoff backoff;
+    long long value = 0;
+    for (std::size_t i = 0; i < round_trips; ++i) {
+      ping.tryPushBack(static_cast<long long>(i));
+      while (!pong.tryPopFront(value)) {
+        backoff.pause();
+      }
+      backoff.reset();
+    }
+    echo.join();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long long>(round_trips));
+}
+
+BENCHMARK_TEMPLATE(BM_SpscThroughput, deque::SpscDeque<long long>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscThroughput, MutexDeque<long long>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscThroughputBulk, deque::SpscDeque<long long>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscThroughputBulk, MutexDeque<long long>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscPingPong, deque::SpscDeque<long long>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscPingPong, MutexDeque<long long>)->UseRealTime();
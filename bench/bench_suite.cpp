@@ -0,0 +1,249 @@
+// 综合基准：两端推入/弹出、FIFO 稳态、随机访问、遍历、中间插入/删除、
+// 复制/赋值、清空与排序，按元素尺寸（4/32/128 字节）与容器规模扫描，
+// 以 std::deque 和 std::vector（连续存储基线）作对照。
+//
+// 机器可读输出：
+//   deque_bench --benchmark_filter=Suite --benchmark_out=suite.json --benchmark_out_format=json
+// 或直接构建 deque_bench_json 目标（结果写到构建目录下的 deque_bench.json）。
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "deque/deque.hpp"
+
+namespace {
+
+using Int = std::int32_t;
+using Blob32 = bench::Blob<32>;
+using Blob128 = bench::Blob<128>;
+
+void containerSizes(benchmark::internal::Benchmark* b) {
+  for (long n : {1L << 10, 1L << 14, 1L << 17}) {
+    b->Arg(n);
+  }
+}
+
+std::size_t sizeArg(const benchmark::State& state) {
+  return static_cast<std::size_t>(state.range(0));
+}
+
+std::vector<std::size_t> randomIndices(std::size_t count) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<std::size_t> dist(0, count - 1);
+  std::vector<std::size_t> indices(count);
+  for (auto& index : indices) {
+    index = dist(rng);
+  }
+  return indices;
+}
+
+template <class Container>
+Container makeShuffled(std::size_t count) {
+  std::vector<typename Container::value_type> values;
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    values.emplace_back(static_cast<std::uint64_t>(i));
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937_64(7));
+  Container c;
+  c.assign(values.begin(), values.end());
+  return c;
+}
+
+}  // namespace
+
+template <class Container>
+static void BM_SuitePushBack(benchmark::State& state) {
+  using T = typename Container::value_type;
+  const std::size_t n = sizeArg(state);
+  for (auto _ : state) {
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) {
+      bench::pushBack(c, T(i));
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuitePushFront(benchmark::State& state) {
+  using T = typename Container::value_type;
+  const std::size_t n = sizeArg(state);
+  for (auto _ : state) {
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) {
+      bench::pushFront(c, T(i));
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuitePopBack(benchmark::State& state) {
+  const auto source = bench::makeFilled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    while (!c.empty()) {
+      bench::popBack(c);
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuitePopFront(benchmark::State& state) {
+  const auto source = bench::makeFilled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    while (!c.empty()) {
+      bench::popFront(c);
+    }
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 队列长度固定为 n，每次迭代尾进头出一个元素。
+template <class Container>
+static void BM_SuiteFifoSteadyState(benchmark::State& state) {
+  using T = typename Container::value_type;
+  auto c = bench::makeFilled<Container>(sizeArg(state));
+  std::uint64_t next = 0;
+  for (auto _ : state) {
+    bench::pushBack(c, T(next++));
+    bench::popFront(c);
+  }
+  benchmark::DoNotOptimize(&c);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container>
+static void BM_SuiteRandomAccess(benchmark::State& state) {
+  const std::size_t n = sizeArg(state);
+  const auto c = bench::makeFilled<Container>(n);
+  const auto indices = randomIndices(n);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += bench::keyOf(c[index]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuiteIterate(benchmark::State& state) {
+  const auto c = bench::makeFilled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& value : c) {
+      sum += bench::keyOf(value);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuiteMiddleInsertErase(benchmark::State& state) {
+  using T = typename Container::value_type;
+  const std::size_t n = sizeArg(state);
+  auto c = bench::makeFilled<Container>(n);
+  const auto middle = static_cast<std::ptrdiff_t>(n / 2);
+  for (auto _ : state) {
+    c.insert(c.begin() + middle, T(n));
+    c.erase(c.begin() + middle);
+  }
+  benchmark::DoNotOptimize(&c);
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <class Container>
+static void BM_SuiteCopy(benchmark::State& state) {
+  const auto source = bench::makeFilled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    Container copy(source);
+    benchmark::DoNotOptimize(&copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuiteAssign(benchmark::State& state) {
+  using T = typename Container::value_type;
+  const auto source = bench::makeFilled<std::vector<T>>(sizeArg(state));
+  Container c;
+  for (auto _ : state) {
+    c.assign(source.begin(), source.end());
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuiteClear(benchmark::State& state) {
+  const auto source = bench::makeFilled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    c.clear();
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_SuiteSort(benchmark::State& state) {
+  const auto source = makeShuffled<Container>(sizeArg(state));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c(source);
+    state.ResumeTiming();
+    std::sort(c.begin(), c.end());
+    benchmark::DoNotOptimize(&c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 三种容器都支持的操作；std::vector 没有头部操作，只参与其余项目。
+#define DEQUE_SUITE_ALL(BM, T)                                    \
+  BENCHMARK_TEMPLATE(BM, deque::Deque<T>)->Apply(containerSizes); \
+  BENCHMARK_TEMPLATE(BM, std::deque<T>)->Apply(containerSizes);   \
+  BENCHMARK_TEMPLATE(BM, std::vector<T>)->Apply(containerSizes)
+
+#define DEQUE_SUITE_DEQUES(BM, T)                                 \
+  BENCHMARK_TEMPLATE(BM, deque::Deque<T>)->Apply(containerSizes); \
+  BENCHMARK_TEMPLATE(BM, std::deque<T>)->Apply(containerSizes)
+
+#define DEQUE_SUITE_FOR_TYPE(T)                     \
+  DEQUE_SUITE_ALL(BM_SuitePushBack, T);             \
+  DEQUE_SUITE_DEQUES(BM_SuitePushFront, T);         \
+  DEQUE_SUITE_ALL(BM_SuitePopBack, T);              \
+  DEQUE_SUITE_DEQUES(BM_SuitePopFront, T);          \
+  DEQUE_SUITE_DEQUES(BM_SuiteFifoSteadyState, T);   \
+  DEQUE_SUITE_ALL(BM_SuiteRandomAccess, T);         \
+  DEQUE_SUITE_ALL(BM_SuiteIterate, T);              \
+  DEQUE_SUITE_ALL(BM_SuiteMiddleInsertErase, T);    \
+  DEQUE_SUITE_ALL(BM_SuiteCopy, T);                 \
+  DEQUE_SUITE_ALL(BM_SuiteAssign, T);               \
+  DEQUE_SUITE_ALL(BM_SuiteClear, T);                \
+  DEQUE_SUITE_ALL(BM_SuiteSort, T)
+
+DEQUE_SUITE_FOR_TYPE(Int);
+DEQUE_SUITE_FOR_TYPE(Blob32);
+DEQUE_SUITE_FOR_TYPE(Blob128);
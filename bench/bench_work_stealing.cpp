@@ -0,0 +1,139 @@
+// 分治求和（fork-join）：每个工作线程一个队列，空闲时随机窃取；
+// 对比 WorkStealingDeque 与互斥锁包装的 Deque，线程数 1..N 观察扩展性
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "deque/deque.hpp"
+#include "deque/detail/concurrent.hpp"
+#include "deque/work_stealing_deque.hpp"
+
+namespace {
+
+constexpr std::uint32_t tree_size = 1u << 22;
+constexpr std::uint32_t grain = 1u << 10;
+
+struct Range {
+  std::uint32_t begin;
+  std::uint32_t end;
+};
+
+// 与 WorkStealingDeque 接口一致的基线：所有者与窃取者共用一把锁。
+class MutexWorkQueue {
+ public:
+  void push(const Range& range) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deque_.pushBack(range);
+  }
+
+  std::optional<Range> pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) {
+      return std::nullopt;
+    }
+    Range range = deque_.back();
+    deque_.popBack();
+    return range;
+  }
+
+  std::optional<Range> steal() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) {
+      return std::nullopt;
+    }
+    Range range = deque_.front();
+    deque_.popFront();
+    return range;
+  }
+
+ private:
+  std::mutex mutex_;
+  deque::Deque<Range> deque_;
+};
+
+std::uint64_t leafWork(std::uint32_t i) {
+  std::uint64_t x = i;
+  x ^= x >> 13;
+  x *= 0x9E3779B97F4A7C15ull;
+  return x ^ (x >> 29);
+}
+
+// 作用：工作线程主循环。先处理自己队列底部的任务，空了再随机窃取；
+// 每个任务不断对半拆分，把右半压回自己的队列，直到小于 grain 再直接计算。
+template <class Queue>
+void worker(std::vector<Queue>& queues, std::size_t id, std::atomic<std::uint32_t>& processed,
+            std::atomic<std::uint64_t>& total) {
+  std::minstd_rand rng(static_cast<unsigned>(id) + 1);
+  deque::detail::Backoff backoff;
+  std::uint64_t sum = 0;
+  while (processed.load(std::memory_order_acquire) < tree_size) {
+    std::optional<Range> task = queues[id].pop();
+    if (!task && queues.size() > 1) {
+      task = queues[rng() % queues.size()].steal();
+    }
+    if (!task) {
+      backoff.pause();
+      continue;
+    }
+    backoff.reset();
+    Range range = *task;
+    while (range.end - range.begin > grain) {
+      std::uint32_t middle = range.begin + (range.end - range.begin) / 2;
+      queues[id].push(Range{middle, range.end});
+      range.end = middle;
+    }
+    for (std::uint32_t i = range.begin; i < range.end; ++i) {
+      sum += leafWork(i);
+    }
+    processed.fetch_add(range.end - range.begin, std::memory_order_release);
+  }
+  total.fetch_add(sum, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+template <class Queue>
+static void BM_ForkJoinTreeSum(benchmark::State& state) {
+  const auto thread_count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::vector<Queue> queues(thread_count);
+    std::atomic<std::uint32_t> processed{0};
+    std::atomic<std::uint64_t> total{0};
+    queues[0].push(Range{0, tree_size});
+
+    std::vector<std::thread> threads;
+    for (std::size_t id = 1; id < thread_count; ++id) {
+      threads.emplace_back([&, id] { worker(queues, id, processed, total); });
+    }
+    worker(queues, 0, processed, total);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    benchmark::DoNotOptimize(total.load());
+  }
+  state.SetItemsProcessed(state.iterations() * tree_size);
+}
+
+static void forkJoinThreads(benchmark::internal::Benchmark* b) {
+  const long max_threads = std::max(4L, static_cast<long>(std::thread::hardware_concurrency()));
+  for (long n = 1; n <= max_threads; n *= 2) {
+    b->Arg(n);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ForkJoinTreeSum, deque::WorkStealingDeque<Range>)
+    ->Apply(forkJoinThreads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ForkJoinTreeSum, MutexWorkQueue)
+    ->Apply(forkJoinThreads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+
+#include "deque/detail/iterator.hpp"
+#include "deque/detail/segment.hpp"
+
+namespace deque {
+
+// Segmented algorithms over Deque iterator ranges.
+// Each walks the range one block-contiguous chunk at a time and runs the
+// standard algorithm on raw pointers, so the inner loop has no block-boundary
+// checks and can be vectorised.
+
+template <class Storage, bool is_const>
+detail::SegmentRange<Storage, is_const> segmentsOf(detail::DequeIterator<Storage, is_const> first,
+                                                   detail::DequeIterator<Storage, is_const> last) {
+  return detail::SegmentRange<Storage, is_const>(first, last);
+}
+
+template <class Storage, bool is_const, class UnaryFunction>
+UnaryFunction forEach(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last,
+                      UnaryFunction fn) {
+  for (auto segment : segmentsOf(first, last)) {
+    for (auto& element : segment) {
+      fn(element);
+    }
+  }
+  return fn;
+}
+
+template <class Storage, bool is_const, class OutputIt>
+OutputIt copy(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last,
+              OutputIt dest) {
+  for (auto segment : segmentsOf(first, last)) {
+    dest = std::copy(segment.begin(), segment.end(), dest);
+  }
+  return dest;
+}
+
+template <class Storage, class T>
+void fill(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last, const T& value) {
+  for (auto segment : segmentsOf(first, last)) {
+    std::fill(segment.begin(), segment.end(), value);
+  }
+}
+
+// 作用：在 [first, last) 中查找第一个等于 value 的元素，未找到时返回 last。
+template <class Storage, bool is_const, class T>
+detail::DequeIterator<Storage, is_const> find(detail::DequeIterator<Storage, is_const> first,
+                                              detail::DequeIterator<Storage, is_const> last, const T& value) {
+  std::ptrdiff_t skipped = 0;
+  for (auto segment : segmentsOf(first, last)) {
+    auto hit = std::find(segment.begin(), segment.end(), value);
+    if (hit != segment.end()) {
+      return first + (skipped + (hit - segment.begin()));
+    }
+    skipped += static_cast<std::ptrdiff_t>(segment.size());
+  }
+  return last;
+}
+
+template <class Storage, bool is_const, class T>
+T accumulate(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last, T init) {
+  for (auto segment : segmentsOf(first, last)) {
+    init = std::accumulate(segment.begin(), segment.end(), std::move(init));
+  }
+  return init;
+}
+
+template <class Storage, bool is_const, class T, class BinaryOperation>
+T accumulate(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last, T init,
+             BinaryOperation op) {
+  for (auto segment : segmentsOf(first, last)) {
+    init = std::accumulate(segment.begin(), segment.end(), std::move(init), op);
+  }
+  return init;
+}
+
+}  // namespace deque
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "deque/detail/concurrent.hpp"
+#include "deque/detail/storage.hpp"
+#include "deque/spsc_deque.hpp"
+
+namespace deque {
+
+// Multi-producer/multi-consumer queue with optional capacity bound.
+// Two-lock design: producers serialise on push_mutex_, consumers on pop_mutex_,
+// and each side drives its end of an SpscDeque (the same block-chained layout),
+// so pushes and pops never contend with each other. An atomic element count
+// decides when the other side's condition variable has to be signalled.
+//
+// close() wakes every waiter; afterwards pushes fail and pops drain what is
+// left, then fail. Bulk pops take up to n elements under a single lock.
+template <class T, class Allocator = std::allocator<T>, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class ConcurrentDeque {
+ public:
+  using value_type = T;
+  using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using size_type = std::size_t;
+  using clock_type = std::chrono::steady_clock;
+
+  static constexpr size_type block_size = BlockSize;
+  static constexpr size_type unbounded = std::numeric_limits<size_type>::max();
+
+  ConcurrentDeque() : ConcurrentDeque(unbounded) {}
+
+  explicit ConcurrentDeque(size_type capacity, const allocator_type& allocator = allocator_type())
+      : queue_(SpscDeque<T, Allocator, BlockSize>::unbounded, allocator), capacity_(capacity) {
+    assert(capacity_ > 0);
+  }
+
+  ConcurrentDeque(const ConcurrentDeque&) = delete;
+  ConcurrentDeque& operator=(const ConcurrentDeque&) = delete;
+
+  size_type capacity() const noexcept { return capacity_; }
+  size_type sizeApprox() const noexcept { return count_.load(std::memory_order_acquire); }
+  bool emptyApprox() const noexcept { return sizeApprox() == 0; }
+
+  // 作用：关闭队列并唤醒所有等待者；之后推入失败，弹出只取走剩余元素。
+  void close() {
+    closed_.store(true, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(push_mutex_);
+      not_full_.notify_all();
+    }
+    std::lock_guard<std::mutex> lock(pop_mutex_);
+    not_empty_.notify_all();
+  }
+
+  bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+  // ---- 推入：阻塞 / 非阻塞 / 限时，返回 false 表示已关闭（或未等到空位）----
+
+  bool pushBack(const T& value) { return push_(value, Wait::block, {}); }
+  bool pushBack(T&& value) { return push_(std::move(value), Wait::block, {}); }
+
+  bool tryPushBack(const T& value) { return push_(value, Wait::none, {}); }
+  bool tryPushBack(T&& value) { return push_(std::move(value), Wait::none, {}); }
+
+  template <class Rep, class Period>
+  bool pushBackFor(const T& value, const std::chrono::duration<Rep, Period>& timeout) {
+    return push_(value, Wait::until, clock_type::now() + timeout);
+  }
+
+  template <class Rep, class Period>
+  bool pushBackFor(T&& value, const std::chrono::duration<Rep, Period>& timeout) {
+    return push_(std::move(value), Wait::until, clock_type::now() + timeout);
+  }
+
+  // ---- 弹出：返回 false 表示队列为空且已关闭（或未等到元素）----
+
+  bool popFront(T& out) { return popBulk_(&out, 1, Wait::block, {}) == 1; }
+  bool tryPopFront(T& out) { return popBulk_(&out, 1, Wait::none, {}) == 1; }
+
+  template <class Rep, class Period>
+  bool popFrontFor(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+    return popBulk_(&out, 1, Wait::until, clock_type::now() + timeout) == 1;
+  }
+
+  // 作用：阻塞到至少有一个元素，然后在一次加锁内最多取走 max_count 个写入 out；
+  // 返回 0 表示队列已关闭且为空。
+  template <class OutputIt>
+  size_type popBulk(OutputIt out, size_type max_count) {
+    return popBulk_(out, max_count, Wait::block, {});
+  }
+
+  template <class OutputIt>
+  size_type tryPopBulk(OutputIt out, size_type max_count) {
+    return popBulk_(out, max_count, Wait::none, {});
+  }
+
+  template <class OutputIt, class Rep, class Period>
+  size_type popBulkFor(OutputIt out, size_type max_count, const std::chrono::duration<Rep, Period>& timeout) {
+    return popBulk_(out, max_count, Wait::until, clock_type::now() + timeout);
+  }
+
+ private:
+  enum class Wait { none, block, until };
+
+  // 作用：在持有 lock 的情况下等待 ready() 成立；关闭、超时或不允许等待时返回 false。
+  template <class Ready>
+  bool wait_(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, Wait wait,
+             clock_type::time_point deadline, Ready ready) {
+    auto done = [&] { return ready() || closed_.load(std::memory_order_acquire); };
+    switch (wait) {
+      case Wait::none:
+        break;
+      case Wait::block:
+        cv.wait(lock, done);
+        break;
+      case Wait::until:
+        cv.wait_until(lock, deadline, done);
+        break;
+    }
+    return ready();
+  }
+
+  template <class U>
+  bool push_(U&& value, Wait wait, clock_type::time_point deadline) {
+    if (closed_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::unique_lock<std::mutex> lock(push_mutex_);
+    bool has_room = wait_(lock, not_full_, wait, deadline,
+                          [this] { return count_.load(std::memory_order_acquire) < capacity_; });
+    if (!has_room || closed_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    queue_.tryEmplaceBack(std::forward<U>(value));
+    size_type before = count_.fetch_add(1, std::memory_order_acq_rel);
+    if (before + 1 < capacity_) {
+      // 还有空位，接力唤醒下一个等待的生产者。
+      not_full_.notify_one();
+    }
+    lock.unlock();
+    if (before == 0) {
+      signalNotEmpty_();
+    }
+    return true;
+  }
+
+  template <class OutputIt>
+  size_type popBulk_(OutputIt out, size_type max_count, Wait wait, clock_type::time_point deadline) {
+    if (max_count == 0) {
+      return 0;
+    }
+    std::unique_lock<std::mutex> lock(pop_mutex_);
+    bool has_items =
+        wait_(lock, not_empty_, wait, deadline, [this] { return count_.load(std::memory_order_acquire) > 0; });
+    if (!has_items) {
+      return 0;
+    }
+    size_type taken = 0;
+    try {
+      queue_.tryPopBulk(out, std::min(max_count, count_.load(std::memory_order_acquire)), taken);
+    } catch (...) {
+      // 写入 out 抛出异常前已经取走的元素同样要从计数中扣除，否则等待者会为不存在的元素醒来。
+      settlePop_(lock, taken);
+      throw;
+    }
+    settlePop_(lock, taken);
+    return taken;
+  }
+
+  // 作用：弹出 taken 个元素后更新计数、释放 lock，并按需唤醒其他消费者与生产者。
+  void settlePop_(std::unique_lock<std::mutex>& lock, size_type taken) {
+    size_type before = count_.fetch_sub(taken, std::memory_order_acq_rel);
+    if (before > taken) {
+      // 还有剩余元素，接力唤醒下一个等待的消费者。
+      not_empty_.notify_one();
+    }
+    lock.unlock();
+    if (taken > 0 && before >= capacity_ && before - taken < capacity_) {
+      signalNotFull_(taken);
+    }
+  }
+
+  // 队列从空变为非空时才需要跨锁唤醒消费者；先加锁再通知，避免与等待者的检查错过。
+  void signalNotEmpty_() {
+    std::lock_guard<std::mutex> lock(pop_mutex_);
+    not_empty_.notify_one();
+  }
+
+  void signalNotFull_(size_type freed) {
+    std::lock_guard<std::mutex> lock(push_mutex_);
+    if (freed == 1) {
+      not_full_.notify_one();
+    } else {
+      not_full_.notify_all();
+    }
+  }
+
+  // queue_ 的生产者端只在 push_mutex_ 下访问，消费者端只在 pop_mutex_ 下访问。
+  SpscDeque<T, Allocator, BlockSize> queue_;
+  alignas(detail::cache_line_size) std::mutex push_mutex_;
+  std::condition_variable not_full_;
+  alignas(detail::cache_line_size) std::mutex pop_mutex_;
+  std::condition_variable not_empty_;
+  alignas(detail::cache_line_size) std::atomic<size_type> count_{0};
+  std::atomic<bool> closed_{false};
+  size_type capacity_;
+};
+
+}  // namespace deque
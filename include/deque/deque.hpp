@@ -4,51 +4,107 @@
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 
 #include "deque/detail/storage.hpp"
 #include "deque/detail/iterator.hpp"
+#include "deque/detail/segment.hpp"
 
 namespace deque {
 
 // Deque container with segmented storage.
 // API uses lowerCamelCase function naming by request.
-template <class T, class Allocator = std::allocator<T>>
+// BlockSize is the number of elements per block; the default targets
+// roughly 4 KiB per block (at least 16 elements), rounded to a power of two.
+template <class T, class Allocator = std::allocator<T>, std::size_t BlockSize = detail::defaultBlockSize<T>()>
 class Deque {
  public:
   using value_type = T;
   using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
   using size_type = std::size_t;
   using difference_type = std::ptrdiff_t;
 
  private:
-  using storage_type = detail::SegmentedStorage<T, Allocator>;
+  using storage_type = detail::SegmentedStorage<T, Allocator, BlockSize>;
 
  public:
   using iterator = detail::DequeIterator<storage_type, false>;
   using const_iterator = detail::DequeIterator<storage_type, true>;
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using block_stats = typename storage_type::BlockStats;
+  using map_growth_policy = typename storage_type::MapGrowthPolicy;
+  using segment = detail::Span<T>;
+  using const_segment = detail::Span<const T>;
+  using segment_range = detail::SegmentRange<storage_type, false>;
+  using const_segment_range = detail::SegmentRange<storage_type, true>;
 
+  static constexpr size_type block_size = storage_type::block_size;
+
+  // An empty deque owns no memory; the block map and the first block are
+  // allocated on the first insertion.
   Deque() = default;
+  explicit Deque(const allocator_type& allocator) noexcept : storage_(allocator) {}
 
   Deque(const Deque& other) = default;
   Deque(Deque&& other) noexcept = default;
 
-  Deque& operator=(Deque other) noexcept(std::is_nothrow_move_constructible_v<storage_type>) {
-    swap(other);
-    return *this;
-  }
+  Deque(const Deque& other, const allocator_type& allocator) : storage_(other.storage_, allocator) {}
+  Deque(Deque&& other, const allocator_type& allocator) : storage_(std::move(other.storage_), allocator) {}
+
+  // Assignment and swap follow the allocator's propagate_on_container_* traits.
+  Deque& operator=(const Deque& other) = default;
+  Deque& operator=(Deque&& other) noexcept(std::is_nothrow_move_assignable_v<storage_type>) = default;
 
   ~Deque() = default;
 
   void swap(Deque& other) noexcept { storage_.swap(other.storage_); }
 
+  allocator_type getAllocator() const noexcept { return storage_.getAllocator(); }
+
   bool empty() const noexcept { return storage_.empty(); }
   size_type size() const noexcept { return storage_.size(); }
 
-  void clear() { storage_.clear(); }
+  // Keeps the block map and every block (cached for reuse), so clearing and
+  // refilling a deque of similar size does not allocate.
+  void clear() noexcept { storage_.clear(); }
+
+  // Blocks drained at one end are cached (up to spareBlockLimit()) and handed
+  // to the other end, so steady-state FIFO traffic performs no allocation.
+  block_stats blockStats() const noexcept { return storage_.blockStats(); }
+  size_type spareBlockLimit() const noexcept { return storage_.spareBlockLimit(); }
+  void setSpareBlockLimit(size_type limit) noexcept { storage_.setSpareBlockLimit(limit); }
+
+  // Controls how the block map grows: the growth factor, whether a sparse map
+  // is re-laid-out in place instead of reallocated, and whether free slots are
+  // biased toward the end that blockStats() shows receiving more pushes.
+  // With `incremental` set, the next map is allocated before the current one
+  // fills up and a bounded number of block pointers is migrated on each push,
+  // so no single pushBack/pushFront copies the whole map. A push in the
+  // opposite direction or a bulk insert that outruns the migration finishes
+  // it in one step.
+  map_growth_policy mapGrowthPolicy() const noexcept { return storage_.mapGrowthPolicy(); }
+  void setMapGrowthPolicy(const map_growth_policy& policy) noexcept { storage_.setMapGrowthPolicy(policy); }
+
+  // Pre-allocates map slots and blocks in one pass so that the next `count`
+  // pushBack (pushFront) calls perform no allocation. Reserved blocks stay
+  // attached past the end (before the beginning) until shrinkToFit().
+  void reserveBack(size_type count) { storage_.reserveBack(count); }
+  void reserveFront(size_type count) { storage_.reserveFront(count); }
+
+  // Number of pushBack (pushFront) calls that can be made before one of
+  // them allocates a block or grows the map.
+  size_type capacityBack() const noexcept { return storage_.capacityBack(); }
+  size_type capacityFront() const noexcept { return storage_.capacityFront(); }
+
+  // Returns every cached and reserved block to the allocator and shrinks the
+  // block map to the range that currently holds elements; an empty deque
+  // releases all of its memory.
+  void shrinkToFit() { storage_.shrinkToFit(); }
 
   iterator begin() noexcept { return iterator(&storage_, 0); }
   const_iterator begin() const noexcept { return const_iterator(&storage_, 0); }
@@ -64,6 +120,16 @@ class Deque {
   reverse_iterator rEnd() noexcept { return reverse_iterator(begin()); }
   const_reverse_iterator rEnd() const noexcept { return const_reverse_iterator(begin()); }
 
+  // Contiguous per-block chunks of the elements, for vectorised loops, memcpy
+  // or writev without per-element index translation. Invalidated like iterators.
+  segment_range segments() noexcept { return segment_range(begin(), end()); }
+  const_segment_range segments() const noexcept { return const_segment_range(begin(), end()); }
+
+  segment_range segments(iterator first, iterator last) noexcept { return segment_range(first, last); }
+  const_segment_range segments(const_iterator first, const_iterator last) const noexcept {
+    return const_segment_range(first, last);
+  }
+
   value_type& front() { return storage_.front(); }
   const value_type& front() const { return storage_.front(); }
 
@@ -79,6 +145,19 @@ class Deque {
   void pushFront(const value_type& value) { storage_.pushFront(value); }
   void pushFront(value_type&& value) { storage_.pushFront(std::move(value)); }
 
+  // Construct the new element in place inside its block slot.
+  template <class... Args>
+  reference emplaceBack(Args&&... args) { return storage_.emplaceBack(std::forward<Args>(args)...); }
+
+  template <class... Args>
+  reference emplaceFront(Args&&... args) { return storage_.emplaceFront(std::forward<Args>(args)...); }
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type index = storage_.emplaceAt(pos.getIndex(), std::forward<Args>(args)...);
+    return iterator(&storage_, index);
+  }
+
   void popBack() { storage_.popBack(); }
   void popFront() { storage_.popFront(); }
 
@@ -88,6 +167,31 @@ class Deque {
     return iterator(&storage_, inserted);
   }
 
+  iterator insert(const_iterator pos, value_type&& value) {
+    size_type index = pos.getIndex();
+    size_type inserted = storage_.insertAt(index, std::move(value));
+    return iterator(&storage_, inserted);
+  }
+
+  iterator insert(const_iterator pos, size_type count, const value_type& value) {
+    size_type index = storage_.insertFill(pos.getIndex(), count, value);
+    return iterator(&storage_, index);
+  }
+
+  // Range insertion reserves all blocks up front and constructs whole
+  // block-contiguous runs at a time for forward ranges.
+  template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type index = storage_.insertRange(pos.getIndex(), first, last);
+    return iterator(&storage_, index);
+  }
+
+  template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  void append(InputIt first, InputIt last) { storage_.insertRange(storage_.size(), first, last); }
+
+  template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  void prepend(InputIt first, InputIt last) { storage_.insertRange(0, first, last); }
+
   iterator erase(const_iterator pos) {
     size_type index = pos.getIndex();
     size_type next_index = storage_.eraseAt(index);
@@ -109,6 +213,21 @@ class Deque {
   template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
   void assign(InputIt first, InputIt last) { storage_.assign(first, last); }
 
+  // Moves [index, size()) into a new deque that shares this deque's
+  // allocator, keeping [0, index). Whole blocks change owner by pointer and
+  // only the elements of the block holding `index` are moved, so the cost is
+  // O(blocks + block_size) rather than O(size()).
+  Deque splitAt(size_type index) { return Deque(storage_.splitAt(index)); }
+
+  // Moves every element of `other` to the end (front) of this deque and
+  // leaves `other` empty. With equal allocators, blocks are transferred by
+  // pointer whenever the two block layouts line up (always the case when
+  // either side is empty, or when re-joining the halves of splitAt); then only
+  // the two half-filled blocks at the seam are merged. Otherwise the shorter
+  // side is moved element by element onto the longer one.
+  void appendSplice(Deque&& other) { storage_.appendSplice(std::move(other.storage_)); }
+  void prependSplice(Deque&& other) { storage_.prependSplice(std::move(other.storage_)); }
+
   friend bool operator==(const Deque& lhs, const Deque& rhs) {
     if (lhs.size() != rhs.size()) {
       return false;
@@ -132,12 +251,22 @@ class Deque {
   friend bool operator>=(const Deque& lhs, const Deque& rhs) { return !(lhs < rhs); }
 
  private:
+  explicit Deque(storage_type&& storage) noexcept : storage_(std::move(storage)) {}
+
   storage_type storage_{};
 };
 
-template <class T, class Allocator>
-inline void swap(Deque<T, Allocator>& lhs, Deque<T, Allocator>& rhs) noexcept {
+template <class T, class Allocator, std::size_t BlockSize>
+inline void swap(Deque<T, Allocator, BlockSize>& lhs, Deque<T, Allocator, BlockSize>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
+namespace pmr {
+
+// Deque whose blocks and block map all come from a std::pmr::memory_resource.
+template <class T, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+using Deque = deque::Deque<T, std::pmr::polymorphic_allocator<T>, BlockSize>;
+
+}  // namespace pmr
+
 }  // namespace deque
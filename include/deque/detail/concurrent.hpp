@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <thread>
+
+namespace deque::detail {
+
+// 并发容器中把生产者/消费者各自的状态放在不同缓存行上，避免伪共享。
+// 固定为 64 字节：std::hardware_destructive_interference_size 在各编译器上的可用性不一致。
+inline constexpr std::size_t cache_line_size = 64;
+
+// 作用：自旋等待时的退让；先忙等若干轮，之后让出 CPU，单核机器上也能推进。
+class Backoff {
+ public:
+  void pause() noexcept {
+    if (spins_ < spin_limit) {
+      ++spins_;
+      return;
+    }
+    std::this_thread::yield();
+  }
+
+  void reset() noexcept { spins_ = 0; }
+
+ private:
+  static constexpr unsigned spin_limit = 64;
+  unsigned spins_ = 0;
+};
+
+}  // namespace deque::detail
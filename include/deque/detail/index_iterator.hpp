@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace deque::detail {
+
+// Random access iterator that addresses its container by logical index;
+// used where the underlying storage can change representation.
+template <class Container, bool is_const>
+class IndexIterator {
+ public:
+  using value_type = typename Container::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<is_const, const value_type*, value_type*>;
+  using iterator_category = std::random_access_iterator_tag;
+
+ private:
+  using container_pointer = std::conditional_t<is_const, const Container*, Container*>;
+
+ public:
+  IndexIterator() = default;
+  IndexIterator(container_pointer container, std::size_t index) noexcept : container_(container), index_(index) {}
+
+  template <bool other_const, class = std::enable_if_t<is_const && !other_const>>
+  IndexIterator(const IndexIterator<Container, other_const>& other) noexcept
+      : container_(other.container_), index_(other.index_) {}
+
+  reference operator*() const { return (*container_)[index_]; }
+  pointer operator->() const { return &(*container_)[index_]; }
+  reference operator[](difference_type n) const { return (*container_)[index_ + static_cast<std::size_t>(n)]; }
+
+  IndexIterator& operator++() {
+    ++index_;
+    return *this;
+  }
+  IndexIterator operator++(int) {
+    IndexIterator tmp = *this;
+    ++index_;
+    return tmp;
+  }
+  IndexIterator& operator--() {
+    --index_;
+    return *this;
+  }
+  IndexIterator operator--(int) {
+    IndexIterator tmp = *this;
+    --index_;
+    return tmp;
+  }
+
+  IndexIterator& operator+=(difference_type n) {
+    index_ += static_cast<std::size_t>(n);
+    return *this;
+  }
+  IndexIterator& operator-=(difference_type n) {
+    index_ -= static_cast<std::size_t>(n);
+    return *this;
+  }
+  IndexIterator operator+(difference_type n) const { return IndexIterator(container_, index_ + static_cast<std::size_t>(n)); }
+  IndexIterator operator-(difference_type n) const { return IndexIterator(container_, index_ - static_cast<std::size_t>(n)); }
+  friend IndexIterator operator+(difference_type n, const IndexIterator& it) { return it + n; }
+
+  difference_type operator-(const IndexIterator& other) const {
+    return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+  }
+
+  bool operator==(const IndexIterator& other) const { return index_ == other.index_; }
+  bool operator!=(const IndexIterator& other) const { return index_ != other.index_; }
+  bool operator<(const IndexIterator& other) const { return index_ < other.index_; }
+  bool operator<=(const IndexIterator& other) const { return index_ <= other.index_; }
+  bool operator>(const IndexIterator& other) const { return index_ > other.index_; }
+  bool operator>=(const IndexIterator& other) const { return index_ >= other.index_; }
+
+  std::size_t getIndex() const noexcept { return index_; }
+
+ private:
+  template <class, bool>
+  friend class IndexIterator;
+
+  container_pointer container_ = nullptr;
+  std::size_t index_ = 0;
+};
+
+}  // namespace deque::detail
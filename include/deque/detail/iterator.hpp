@@ -6,6 +6,13 @@
 
 namespace deque::detail {
 
+template <class StorageType, bool is_const>
+class SegmentIterator;
+
+// Segment-aware random access iterator.
+// Caches the current block (first_/last_) and the map slot (node_) so that
+// ++, -- and dereference are pointer bumps; only crossing a block boundary
+// touches the map. The storage pointer is kept for index conversion.
 template <class StorageType, bool is_const>
 class DequeIterator {
  public:
@@ -19,21 +26,39 @@ class DequeIterator {
 
   using iterator_category = std::random_access_iterator_tag;
 
+ private:
+  using storage_pointer = std::conditional_t<is_const, const storage_type*, storage_type*>;
+  using map_pointer = value_type* const*;
+
+  static constexpr difference_type block_size = static_cast<difference_type>(storage_type::block_size);
+
+ public:
   DequeIterator() = default;
   //explicit:防止构造函数内容隐式转换
-  explicit DequeIterator(std::conditional_t<is_const, const storage_type*, storage_type*> storage, std::size_t index)
-      : storage_(storage), index_(index) {}
+  explicit DequeIterator(storage_pointer storage, std::size_t index) : storage_(storage) {
+    // 未分配映射数组的空容器：begin() 与 end() 都停在空指针上，二者相等、距离为 0。
+    if (!storage_->hasMap()) {
+      return;
+    }
+    auto location = storage_->locate(index);
+    setNode_(storage_->blockSlot(location.block_index));
+    cur_ = first_ + location.offset;
+  }
 
   //让非const 迭代器能够隐式转换为 const 迭代器
   template <bool other_const, class = std::enable_if_t<is_const && !other_const>>
   DequeIterator(const DequeIterator<storage_type, other_const>& other)
-      : storage_(other.storage_), index_(other.index_) {}
+      : storage_(other.storage_), node_(other.node_), cur_(other.cur_), first_(other.first_), last_(other.last_) {}
 
-  reference operator*() const { return storage_->atIndex(index_); }
-  pointer operator->() const { return &storage_->atIndex(index_); }
+  reference operator*() const { return *cur_; }
+  pointer operator->() const { return cur_; }
 
   DequeIterator& operator++() {
-    ++index_;
+    ++cur_;
+    if (cur_ == last_) {
+      setNode_(node_ + 1);
+      cur_ = first_;
+    }
     return *this;
   }
 
@@ -44,7 +69,11 @@ class DequeIterator {
   }
 
   DequeIterator& operator--() {
-    --index_;
+    if (cur_ == first_) {
+      setNode_(node_ - 1);
+      cur_ = last_;
+    }
+    --cur_;
     return *this;
   }
 
@@ -55,14 +84,18 @@ class DequeIterator {
   }
 
   DequeIterator& operator+=(difference_type n) {
-    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+    difference_type offset = n + (cur_ - first_);
+    if (offset >= 0 && offset < block_size) {
+      cur_ += n;
+      return *this;
+    }
+    difference_type node_offset = offset > 0 ? offset / block_size : -((-offset - 1) / block_size) - 1;
+    setNode_(node_ + node_offset);
+    cur_ = first_ + (offset - node_offset * block_size);
     return *this;
   }
 
-  DequeIterator& operator-=(difference_type n) {
-    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) - n);
-    return *this;
-  }
+  DequeIterator& operator-=(difference_type n) { return *this += -n; }
 
   DequeIterator operator+(difference_type n) const {
     DequeIterator tmp = *this;
@@ -77,27 +110,43 @@ class DequeIterator {
   }
 
   difference_type operator-(const DequeIterator& other) const {
-    return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    return (node_ - other.node_) * block_size + (cur_ - first_) - (other.cur_ - other.first_);
   }
 
   reference operator[](difference_type n) const { return *(*this + n); }
 
-  bool operator==(const DequeIterator& other) const { return storage_ == other.storage_ && index_ == other.index_; }
+  // cur_ 唯一确定一个位置（finish 永远不会停在块尾），所以只需比较 cur_。
+  bool operator==(const DequeIterator& other) const { return cur_ == other.cur_; }
   bool operator!=(const DequeIterator& other) const { return !(*this == other); }
 
-  bool operator<(const DequeIterator& other) const { return index_ < other.index_; }
-  bool operator<=(const DequeIterator& other) const { return index_ <= other.index_; }
-  bool operator>(const DequeIterator& other) const { return index_ > other.index_; }
-  bool operator>=(const DequeIterator& other) const { return index_ >= other.index_; }
+  bool operator<(const DequeIterator& other) const {
+    return node_ == other.node_ ? cur_ < other.cur_ : node_ < other.node_;
+  }
+  bool operator<=(const DequeIterator& other) const { return !(other < *this); }
+  bool operator>(const DequeIterator& other) const { return other < *this; }
+  bool operator>=(const DequeIterator& other) const { return !(*this < other); }
 
-  std::size_t getIndex() const noexcept { return index_; }
+  std::size_t getIndex() const noexcept {
+    return storage_->indexOf(node_, static_cast<std::size_t>(cur_ - first_));
+  }
 
  private:
   template <class, bool>
   friend class DequeIterator;
+  template <class, bool>
+  friend class SegmentIterator;
+
+  void setNode_(map_pointer node) noexcept {
+    node_ = node;
+    first_ = *node;
+    last_ = first_ + block_size;
+  }
 
-  std::conditional_t<is_const, const storage_type*, storage_type*> storage_ = nullptr;
-  std::size_t index_ = 0;
+  storage_pointer storage_ = nullptr;
+  map_pointer node_ = nullptr;
+  value_type* cur_ = nullptr;
+  value_type* first_ = nullptr;
+  value_type* last_ = nullptr;
 };
 
 template <class StorageType, bool is_const>
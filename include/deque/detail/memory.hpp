@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstring>   //std::memcpy
+#include <iterator>  //std::next
 #include <memory>   //std::allocator_traits
+#include <memory_resource>  //std::pmr::polymorphic_allocator
 #include <new>      //placement new
 #include <type_traits>   //std::is_nothrow_destructible
 #include <utility>     //std::forward
@@ -34,4 +38,129 @@ inline void deallocateBlock(Allocator& allocator,
   std::allocator_traits<Allocator>::deallocate(allocator, ptr, count);
 }
 
+// 检测分配器是否自带 construct/destroy 成员（任意一种常见签名即可）。
+template <class Allocator, class T, class = void>
+struct HasConstructMember : std::false_type {};
+template <class Allocator, class T>
+struct HasConstructMember<Allocator, T, std::void_t<decltype(std::declval<Allocator&>().construct(std::declval<T*>()))>>
+    : std::true_type {};
+
+template <class Allocator, class T, class = void>
+struct HasCopyConstructMember : std::false_type {};
+template <class Allocator, class T>
+struct HasCopyConstructMember<
+    Allocator, T, std::void_t<decltype(std::declval<Allocator&>().construct(std::declval<T*>(), std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <class Allocator, class T, class = void>
+struct HasDestroyMember : std::false_type {};
+template <class Allocator, class T>
+struct HasDestroyMember<Allocator, T, std::void_t<decltype(std::declval<Allocator&>().destroy(std::declval<T*>()))>>
+    : std::true_type {};
+
+template <class Allocator, class T>
+inline constexpr bool has_custom_construct_v = HasConstructMember<Allocator, T>::value ||
+                                               HasCopyConstructMember<Allocator, T>::value ||
+                                               HasDestroyMember<Allocator, T>::value;
+
+// 默认分配器的 construct/destroy 就是 placement new 与析构函数调用，此时可以直接使用
+// 标准库的批量构造算法；其它分配器逐个调用 construct/destroy。
+// polymorphic_allocator 只对 uses-allocator 类型做额外处理，其余类型同样等价于 placement new；
+// 没有 construct/destroy 成员的分配器（例如 HugePageAllocator）经 allocator_traits 也退化为 placement new。
+template <class Allocator, class T>
+inline constexpr bool uses_default_construct_v =
+    std::is_same_v<Allocator, std::allocator<T>> ||
+    (std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>> && !std::uses_allocator_v<T, Allocator>) ||
+    !has_custom_construct_v<Allocator, T>;
+
+// 平凡可复制且使用默认 construct 的元素可以按字节整体复制（memcpy/memmove）。
+template <class Allocator, class T>
+inline constexpr bool is_bitwise_copyable_v = uses_default_construct_v<Allocator, T> && std::is_trivially_copyable_v<T>;
+
+// 平凡可析构且使用默认 destroy 的元素销毁时什么也不用做。
+template <class Allocator, class T>
+inline constexpr bool is_trivially_destroyable_v =
+    uses_default_construct_v<Allocator, T> && std::is_trivially_destructible_v<T>;
+
+template <class Allocator, class T>
+inline void destroyN(Allocator& allocator, T* ptr, std::size_t count) noexcept {
+  if constexpr (is_trivially_destroyable_v<Allocator, T>) {
+    (void)allocator;
+    (void)ptr;
+    (void)count;
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      destroyAt(allocator, ptr + i);
+    }
+  }
+}
+
+// 作用：在 dest 开始的 count 个未初始化槽位上依次复制构造 first 起的元素，返回前进后的 first。
+// 构造失败时已构造的元素会被销毁，异常继续向外抛出。
+template <class Allocator, class T, class ForwardIt>
+inline ForwardIt uninitializedCopyN(Allocator& allocator, ForwardIt first, std::size_t count, T* dest) {
+  if constexpr (is_bitwise_copyable_v<Allocator, T> && std::is_pointer_v<ForwardIt> &&
+                std::is_same_v<std::remove_cv_t<std::remove_pointer_t<ForwardIt>>, T>) {
+    if (count != 0) {
+      std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return first + count;
+  } else if constexpr (uses_default_construct_v<Allocator, T>) {
+    ForwardIt last = std::next(first, static_cast<typename std::iterator_traits<ForwardIt>::difference_type>(count));
+    std::uninitialized_copy(first, last, dest);
+    return last;
+  } else {
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i, ++first) {
+        constructAt(allocator, dest + i, *first);
+      }
+    } catch (...) {
+      destroyN(allocator, dest, i);
+      throw;
+    }
+    return first;
+  }
+}
+
+// 作用：在 dest 开始的 count 个未初始化槽位上用 value 复制构造元素；失败时回滚。
+template <class Allocator, class T>
+inline void uninitializedFillN(Allocator& allocator, T* dest, std::size_t count, const T& value) {
+  if constexpr (is_bitwise_copyable_v<Allocator, T>) {
+    // 先复制到局部变量，循环体里没有别名，编译器可以生成向量化的存储指令。
+    const T copy = value;
+    std::fill_n(dest, count, copy);
+  } else if constexpr (uses_default_construct_v<Allocator, T>) {
+    std::uninitialized_fill_n(dest, count, value);
+  } else {
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        constructAt(allocator, dest + i, value);
+      }
+    } catch (...) {
+      destroyN(allocator, dest, i);
+      throw;
+    }
+  }
+}
+
+// 作用：在 dest 开始的 count 个未初始化槽位上值初始化元素；失败时回滚。
+template <class Allocator, class T>
+inline void uninitializedValueConstructN(Allocator& allocator, T* dest, std::size_t count) {
+  if constexpr (uses_default_construct_v<Allocator, T>) {
+    std::uninitialized_value_construct_n(dest, count);
+  } else {
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        constructAt(allocator, dest + i);
+      }
+    } catch (...) {
+      destroyN(allocator, dest, i);
+      throw;
+    }
+  }
+}
+
 }  // namespace deque::detail
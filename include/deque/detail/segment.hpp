@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "deque/detail/iterator.hpp"
+
+namespace deque::detail {
+
+// Minimal C++17 stand-in for std::span: a pointer and a length describing
+// one contiguous run of elements inside a single block.
+template <class T>
+class Span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T*;
+  using reference = T&;
+  using iterator = T*;
+
+  constexpr Span() noexcept = default;
+  constexpr Span(T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+  // 允许 Span<T> 隐式转换为 Span<const T>
+  template <class U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr Span(const Span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+  constexpr pointer data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr size_type sizeBytes() const noexcept { return size_ * sizeof(T); }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr reference operator[](size_type index) const noexcept {
+    assert(index < size_);
+    return data_[index];
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_type size_ = 0;
+};
+
+// Forward iterator over the contiguous chunks of a deque range: one Span per
+// block touched, the first and last possibly partial. Never yields an empty span.
+template <class StorageType, bool is_const>
+class SegmentIterator {
+ public:
+  using element_type = std::conditional_t<is_const, const typename StorageType::value_type,
+                                          typename StorageType::value_type>;
+  using value_type = Span<element_type>;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type;
+  using pointer = void;
+  using iterator_category = std::forward_iterator_tag;
+
+ private:
+  using map_pointer = typename StorageType::value_type* const*;
+
+  static constexpr std::size_t block_size = StorageType::block_size;
+
+ public:
+  SegmentIterator() = default;
+
+  // 作用：以 [first, last) 的端点构造；first == last 时即为末尾迭代器。
+  SegmentIterator(const DequeIterator<StorageType, is_const>& first, const DequeIterator<StorageType, is_const>& last)
+      : node_(first.node_), cur_(first.cur_), last_node_(last.node_), last_cur_(last.cur_) {}
+
+  value_type operator*() const {
+    assert(cur_ != last_cur_);
+    element_type* chunk_end = node_ == last_node_ ? last_cur_ : *node_ + block_size;
+    return value_type(cur_, static_cast<std::size_t>(chunk_end - cur_));
+  }
+
+  SegmentIterator& operator++() {
+    if (node_ == last_node_) {
+      cur_ = last_cur_;
+    } else {
+      ++node_;
+      cur_ = *node_;
+    }
+    return *this;
+  }
+
+  SegmentIterator operator++(int) {
+    SegmentIterator tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+
+  // 与 DequeIterator 相同，cur_ 唯一确定位置。
+  bool operator==(const SegmentIterator& other) const { return cur_ == other.cur_; }
+  bool operator!=(const SegmentIterator& other) const { return !(*this == other); }
+
+ private:
+  map_pointer node_ = nullptr;
+  element_type* cur_ = nullptr;
+  map_pointer last_node_ = nullptr;
+  element_type* last_cur_ = nullptr;
+};
+
+// Range of Spans covering [first, last) of a deque, usable in range-for.
+// Spans stay valid until the deque is modified.
+template <class StorageType, bool is_const>
+class SegmentRange {
+ public:
+  using iterator = SegmentIterator<StorageType, is_const>;
+  using value_type = typename iterator::value_type;
+
+  SegmentRange(const DequeIterator<StorageType, is_const>& first, const DequeIterator<StorageType, is_const>& last)
+      : begin_(first, last), end_(last, last) {}
+
+  iterator begin() const noexcept { return begin_; }
+  iterator end() const noexcept { return end_; }
+
+  bool empty() const noexcept { return begin_ == end_; }
+
+ private:
+  iterator begin_;
+  iterator end_;
+};
+
+}  // namespace deque::detail
@@ -3,21 +3,61 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "deque/detail/iterator.hpp"
 #include "deque/detail/memory.hpp"
 
 namespace deque::detail {
 
+// 默认块大小按字节预算计算：每块约 default_block_bytes 字节，至少 min_block_elements 个元素，
+// 并向下取整到 2 的幂，使 locate_ 可以使用移位/掩码代替除法。
+inline constexpr std::size_t default_block_bytes = 4096;
+inline constexpr std::size_t min_block_elements = 16;
+
+constexpr bool isPowerOfTwo(std::size_t n) noexcept { return n != 0 && (n & (n - 1)) == 0; }
+
+constexpr std::size_t floorPowerOfTwo(std::size_t n) noexcept {
+  std::size_t result = 1;
+  while (result <= n / 2) {
+    result *= 2;
+  }
+  return result;
+}
+
+constexpr std::size_t ceilPowerOfTwo(std::size_t n) noexcept {
+  std::size_t result = 1;
+  while (result < n) {
+    result *= 2;
+  }
+  return result;
+}
+
+constexpr std::size_t log2OfPowerOfTwo(std::size_t n) noexcept {
+  std::size_t shift = 0;
+  while ((std::size_t{1} << shift) < n) {
+    ++shift;
+  }
+  return shift;
+}
+
+template <class T>
+constexpr std::size_t defaultBlockSize() noexcept {
+  constexpr std::size_t by_bytes = default_block_bytes / sizeof(T);
+  return by_bytes <= min_block_elements ? min_block_elements : floorPowerOfTwo(by_bytes);
+}
+
 // A segmented storage similar to std::deque's model:
-// - data stored in fixed-size blocks
+// - data stored in fixed-size blocks of BlockSize elements
 // - an index array ("map") stores pointers to blocks
 // - start/finish are cursors into the segmented space
-template <class T, class Allocator = std::allocator<T>>
+template <class T, class Allocator = std::allocator<T>, std::size_t BlockSize = defaultBlockSize<T>()>
 class SegmentedStorage {
  public:
   using value_type = T;
@@ -27,21 +67,73 @@ class SegmentedStorage {
   using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
   using allocator_traits = std::allocator_traits<allocator_type>;
 
-  using map_allocator_type = std::allocator<T*>;
+  // 映射数组与块使用同一个分配器（重新绑定到 T*），整个容器都能放进同一个内存资源。
+  using map_allocator_type = typename allocator_traits::template rebind_alloc<T*>;
   using map_allocator_traits = std::allocator_traits<map_allocator_type>;
 
-  static constexpr size_type block_size = 64;
+  using iterator = DequeIterator<SegmentedStorage, false>;
+  using const_iterator = DequeIterator<SegmentedStorage, true>;
 
-  SegmentedStorage() {
-    initEmpty_();
-  }
+  static constexpr size_type block_size = BlockSize;
+  static_assert(block_size > 0, "BlockSize must be positive");
+  // 空闲块缓存的默认上限（块数）。
+  static constexpr size_type default_spare_block_limit = 4;
+  static constexpr size_type initial_map_capacity = 8;
+
+  // 块与映射数组的分配统计，用于验证稳态下不再触发分配。
+  struct BlockStats {
+    size_type block_allocations = 0;    // 向分配器申请的块数
+    size_type block_deallocations = 0;  // 归还给分配器的块数
+    size_type block_reuses = 0;         // 从空闲缓存中复用的块数
+    size_type map_allocations = 0;      // 映射数组的分配次数
+    size_type spare_blocks = 0;         // 当前缓存中的空闲块数
+    size_type resident_blocks = 0;      // 当前持有的全部块数（映射数组中 + 缓存中）
+    size_type map_recenters = 0;        // 映射数组原地搬移（不重新分配）的次数
+    size_type blocks_pushed_back = 0;   // 末尾推入跨进新块的次数
+    size_type blocks_pushed_front = 0;  // 前端推入跨进新块的次数
+    size_type blocks_spliced_in = 0;    // 拆分/拼接时从其他容器接管的块数
+    size_type blocks_spliced_out = 0;   // 拆分/拼接时转交给其他容器的块数
+    size_type map_migrations = 0;       // 增量增长完成搬移、切换到新映射数组的次数
+  };
+
+  // 映射数组的增长策略。两端推入的块数（BlockStats::blocks_pushed_*）记录了增长方向，
+  // bias_to_hot_end 时据此把空闲槽位偏向增长更快的一端。
+  struct MapGrowthPolicy {
+    double growth_factor = 2.0;     // 重新分配时的扩容倍数，必须大于 1
+    bool recenter_in_place = true;  // 映射数组足够稀疏时原地搬移，不重新分配
+    bool bias_to_hot_end = true;    // false 时空闲槽位在两端平分
+    bool incremental = false;       // 提前分配新映射数组，每次推入只搬移有限个槽位
+  };
+
+  // 偏向热端时，冷端至少保留的空闲槽位比例，避免推入方向改变时反复搬移。
+  static constexpr double cold_end_share = 1.0 / 16;
+  // 增量增长时每次推入写入新映射数组的槽位数；块越小跨块越频繁，每次要多搬一些，
+  // 保证搬移总能在增长的一端用完空槽位之前完成。
+  static constexpr size_type incremental_map_step = std::max<size_type>(8, 128 / block_size);
+
+  // 空容器不持有映射数组和任何块，第一次插入时才分配（见 reserveMap_）。
+  SegmentedStorage() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) : map_allocator_(allocator_) {}
+
+  explicit SegmentedStorage(const allocator_type& allocator) noexcept
+      : allocator_(allocator), map_allocator_(allocator_) {}
 // 作用：拷贝构造函数，创建一个新的 SegmentedStorage 对象作为 other 的副本。
-  SegmentedStorage(const SegmentedStorage& other) : allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
-    initEmpty_();
+  SegmentedStorage(const SegmentedStorage& other)
+      : SegmentedStorage(other, allocator_traits::select_on_container_copy_construction(other.allocator_)) {}
+// 作用：使用指定分配器的拷贝构造函数。
+  SegmentedStorage(const SegmentedStorage& other, const allocator_type& allocator)
+      : spare_limit_(other.spare_limit_),
+        growth_policy_(other.growth_policy_),
+        allocator_(allocator),
+        map_allocator_(allocator_) {
+    if (other.size_ == 0) {
+      return;
+    }
     try {
-      for (size_type i = 0; i < other.size_; ++i) {
-        pushBack(other.atIndex(i));
-      }
+      // 一次预留全部块，再按源容器的块连续片段批量复制；平凡可复制类型走 memcpy。
+      reserveBackSlots_(other.size_);
+      other.forEachSegment_(0, other.size_, [this](const T* src, size_type count) {
+        appendWith_(count, copier_(src));
+      });
     } catch (...) {
       destroyAll_();
       freeAllBlocks_();
@@ -49,7 +141,7 @@ class SegmentedStorage {
       throw;
     }
   }
-//作用：移动构造函数，将 other 的资源转移到新创建的 SegmentedStorage 对象中。
+//作用：移动构造函数，将 other 的资源转移到新创建的 SegmentedStorage 对象中；other 回到未分配的空状态，仍可继续使用。
   SegmentedStorage(SegmentedStorage&& other) noexcept
       : map_(other.map_),
         map_capacity_(other.map_capacity_),
@@ -58,7 +150,17 @@ class SegmentedStorage {
         finish_block_(other.finish_block_),
         finish_offset_(other.finish_offset_),
         size_(other.size_),
-        allocator_(std::move(other.allocator_)) {
+        spare_head_(other.spare_head_),
+        spare_count_(other.spare_count_),
+        spare_limit_(other.spare_limit_),
+        growth_policy_(other.growth_policy_),
+        stats_(other.stats_),
+        next_map_(other.next_map_),
+        next_capacity_(other.next_capacity_),
+        next_filled_(other.next_filled_),
+        next_shift_(other.next_shift_),
+        allocator_(std::move(other.allocator_)),
+        map_allocator_(std::move(other.map_allocator_)) {
     other.map_ = nullptr;
     other.map_capacity_ = 0;
     other.start_block_ = 0;
@@ -66,38 +168,243 @@ class SegmentedStorage {
     other.finish_block_ = 0;
     other.finish_offset_ = 0;
     other.size_ = 0;
+    other.spare_head_ = nullptr;
+    other.spare_count_ = 0;
+    other.stats_ = BlockStats{};
+    other.next_map_ = nullptr;
+    other.next_capacity_ = 0;
+    other.next_filled_ = 0;
+    other.next_shift_ = 0;
+  }
+// 作用：使用指定分配器的移动构造函数；分配器不相等时只能逐个移动元素。
+  SegmentedStorage(SegmentedStorage&& other, const allocator_type& allocator) : SegmentedStorage(allocator) {
+    if (allocator_ == other.allocator_) {
+      swapContents_(other);
+      return;
+    }
+    spare_limit_ = other.spare_limit_;
+    growth_policy_ = other.growth_policy_;
+    insertRange(0, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+  }
+// 作用：拷贝赋值。propagate_on_container_copy_assignment 为真时连同分配器一起复制，
+  // 否则保留自己的分配器；先在副本中构造好再交换，保证强异常安全。
+  SegmentedStorage& operator=(const SegmentedStorage& other) {
+    if (this != &other) {
+      SegmentedStorage copy(other, propagate_on_copy_assignment::value ? other.allocator_ : allocator_);
+      if constexpr (propagate_on_copy_assignment::value) {
+        swapAllocators_(copy);
+      }
+      swapContents_(copy);
+    }
+    return *this;
   }
-// 作用：赋值运算符，使用 copy-and-swap 技巧实现异常安全的赋值操作。
-  SegmentedStorage& operator=(SegmentedStorage other) noexcept(std::is_nothrow_move_constructible_v<allocator_type>) {
-    swap(other);
+// 作用：移动赋值。可以接管 other 的块时直接接管，否则按自己的分配器逐个移动元素。
+  SegmentedStorage& operator=(SegmentedStorage&& other) noexcept(propagate_on_move_assignment::value ||
+                                                                 allocator_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    // 临时对象 moved 的分配器要么需要传播过来，要么与自己的相等，交换后旧的块随它一起释放。
+    if constexpr (propagate_on_move_assignment::value) {
+      SegmentedStorage moved(std::move(other));
+      swapAllocators_(moved);
+      swapContents_(moved);
+    } else if constexpr (allocator_traits::is_always_equal::value) {
+      SegmentedStorage moved(std::move(other));
+      swapContents_(moved);
+    } else {
+      SegmentedStorage moved(std::move(other), allocator_);
+      swapContents_(moved);
+    }
     return *this;
   }
 
+  allocator_type getAllocator() const noexcept { return allocator_; }
+
   ~SegmentedStorage() {
     destroyAll_();
     freeAllBlocks_();
     freeMap_();
   }
 // 作用：交换两个 SegmentedStorage 对象的内容。
+  // propagate_on_container_swap 为假时分配器留在原处，此时要求两个分配器相等。
   void swap(SegmentedStorage& other) noexcept {
-    using std::swap;
-    swap(map_, other.map_);
-    swap(map_capacity_, other.map_capacity_);
-    swap(start_block_, other.start_block_);
-    swap(start_offset_, other.start_offset_);
-    swap(finish_block_, other.finish_block_);
-    swap(finish_offset_, other.finish_offset_);
-    swap(size_, other.size_);
-    swap(allocator_, other.allocator_);
+    if constexpr (allocator_traits::propagate_on_container_swap::value) {
+      swapAllocators_(other);
+    } else {
+      assert(allocator_ == other.allocator_);
+    }
+    swapContents_(other);
   }
 
+  struct Location {
+    size_type block_index;
+    size_type offset;
+  };
+
   bool empty() const noexcept { return size_ == 0; }
   size_type size() const noexcept { return size_; }
 
-  void clear() {
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size_); }
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  BlockStats blockStats() const noexcept {
+    BlockStats stats = stats_;
+    stats.spare_blocks = spare_count_;
+    stats.resident_blocks = stats_.block_allocations + stats_.blocks_spliced_in - stats_.block_deallocations -
+                            stats_.blocks_spliced_out;
+    return stats;
+  }
+
+  size_type spareBlockLimit() const noexcept { return spare_limit_; }
+
+  MapGrowthPolicy mapGrowthPolicy() const noexcept { return growth_policy_; }
+
+  // 作用：设置映射数组的增长策略，下一次映射数组扩展时生效；关闭增量增长时放弃进行中的搬移。
+  void setMapGrowthPolicy(const MapGrowthPolicy& policy) noexcept {
+    assert(policy.growth_factor > 1.0);
+    growth_policy_ = policy;
+    if (!policy.incremental) {
+      abortMigration_();
+    }
+  }
+
+  // 作用：设置空闲块缓存上限，超出新上限的缓存块立即归还给分配器。
+  void setSpareBlockLimit(size_type limit) noexcept {
+    spare_limit_ = limit;
+    while (spare_count_ > spare_limit_) {
+      T* block = popSpare_();
+      deallocateBlock_(block);
+    }
+  }
+
+  // 作用：返回逻辑索引 index（允许等于 size()）所在的块索引与块内偏移，供迭代器定位使用。
+  Location locate(size_type index) const noexcept {
+    assert(index <= size_);
+    return locate_(index);
+  }
+
+  // 作用：返回映射数组中第 block_index 个槽位的地址，迭代器以此在块之间移动。
+  T* const* blockSlot(size_type block_index) const noexcept {
+    assert(block_index < map_capacity_);
+    return map_ + block_index;
+  }
+
+  // 作用：是否已经分配了映射数组；未分配时容器必然为空，迭代器不能访问映射数组。
+  bool hasMap() const noexcept { return map_ != nullptr; }
+
+  // 作用：locate() 的逆运算，根据块槽位和块内偏移计算逻辑索引。
+  size_type indexOf(T* const* slot, size_type offset) const noexcept {
+    size_type block_index = static_cast<size_type>(slot - map_);
+    return (block_index - start_block_) * block_size + offset - start_offset_;
+  }
+
+  // 作用：释放全部空闲块和预留块，并把映射数组收缩到刚好容纳当前元素；
+  // 空容器连映射数组一起释放，回到未分配状态。
+  void shrinkToFit() {
+    abortMigration_();
+    if (size_ == 0) {
+      freeAllBlocks_();
+      freeMap_();
+      start_block_ = 0;
+      start_offset_ = 0;
+      finish_block_ = 0;
+      finish_offset_ = 0;
+      return;
+    }
+    releaseOutOfRange_();
+    while (spare_head_ != nullptr) {
+      deallocateBlock_(popSpare_());
+    }
+    size_type used_count = (finish_block_ - start_block_) + 1;
+    size_type new_capacity = std::max(initial_map_capacity, used_count + 2);
+    if (new_capacity < map_capacity_) {
+      relocateMap_(new_capacity, placeRun_(new_capacity, used_count, 0, false));
+    }
+  }
+
+  // 作用：返回在末尾还能连续 pushBack 而不触发任何分配（块或映射数组）的元素个数。
+  // 可用槽位包括 finish 块的剩余部分和其后连续的预留块；每次 pushBack 要求 finish 之后
+  // 还有一个映射槽位，填到最后一个块的最后一个槽位时又要求再下一个块已经存在。
+  size_type capacityBack() const noexcept {
+    if (map_ == nullptr || finish_block_ + 2 > map_capacity_) {
+      return 0;
+    }
+    size_type last_block = lastAllocatedBlock_();
+    size_type usable_block = std::min(last_block, map_capacity_ - 2);
+    size_type count = (usable_block - finish_block_ + 1) * block_size - finish_offset_;
+    return usable_block == last_block ? count - 1 : count;
+  }
+
+  // 作用：返回在前端还能连续 pushFront 而不触发任何分配的元素个数。
+  // 每次 pushFront 要求 start 所在块之前还有一个映射槽位，跨进新块时要求该块已经存在。
+  size_type capacityFront() const noexcept {
+    if (map_ == nullptr || start_block_ == 0) {
+      return 0;
+    }
+    size_type first_block = firstAllocatedBlock_();
+    if (first_block == 0) {
+      return (start_block_ - 1) * block_size + start_offset_ + 1;
+    }
+    return (start_block_ - first_block) * block_size + start_offset_;
+  }
+
+  // 作用：一次性扩展映射数组并分配块，保证随后 count 次 pushBack 不触发任何分配。
+  // 预留的块挂在 finish 之后的槽位上，映射数组搬移或居中时随使用中的块一起移动。
+  void reserveBack(size_type count) {
+    if (count == 0 || capacityBack() >= count) {
+      return;
+    }
+    ensureMap_();
+    // 第 count 次 pushBack 之前 finish 所在块相对当前 finish 块的偏移为 (target - 1) / block_size，
+    // 它之后必须还有一个映射槽位；完成后 finish 落在偏移 target / block_size 的块上。
+    size_type target = finish_offset_ + count;
+    reserveMap_((target - 1) / block_size + 1, false);
+    for (size_type i = 1; i <= target / block_size; ++i) {
+      allocateBlockIfNeeded_(finish_block_ + i);
+    }
+  }
+
+  // 作用：一次性扩展映射数组并分配块，保证随后 count 次 pushFront 不触发任何分配。
+  void reserveFront(size_type count) {
+    if (count == 0 || capacityFront() >= count) {
+      return;
+    }
+    ensureMap_();
+    // 第 count 次 pushFront 之前 start 已经向前跨过 crossed 个块，此时它之前仍需一个映射槽位；
+    // 完成后 start 向前跨过 blocks 个块，这些块都要预先分配。
+    size_type crossed = count - 1 > start_offset_ ? (count - 1 - start_offset_ + block_size - 1) / block_size : 0;
+    size_type blocks = count > start_offset_ ? (count - start_offset_ + block_size - 1) / block_size : 0;
+    reserveMap_(crossed + 1, true);
+    for (size_type i = 1; i <= blocks; ++i) {
+      allocateBlockIfNeeded_(start_block_ - i);
+    }
+  }
+
+  // 作用：销毁全部元素但保留容量：映射数组原样保留，一个块留下作为新的起点，
+  // 其余块全部放入空闲缓存（不受 spare_limit_ 约束），下一批插入直接复用，不再触发分配。
+  void clear() noexcept {
+    abortMigration_();
     destroyAll_();
-    // Keep one central block allocated for future growth, free the rest.
-    resetToCenter_();
+    if (map_ == nullptr) {
+      return;
+    }
+    T* kept_block = map_[start_block_];
+    map_[start_block_] = nullptr;
+    for (size_type i = 0; i < map_capacity_; ++i) {
+      if (map_[i] != nullptr) {
+        cacheBlock_(map_[i]);
+        map_[i] = nullptr;
+      }
+    }
+    // 按增长策略摆放起点：偏向热端时把大部分空槽位留给推入更多的一端。
+    start_block_ = placeRun_(map_capacity_, 1, 0, false);
+    finish_block_ = start_block_;
+    map_[start_block_] = kept_block;
+    start_offset_ = block_size / 2;
+    finish_offset_ = start_offset_;
   }
 
   T& atIndex(size_type index) {
@@ -138,6 +445,17 @@ class SegmentedStorage {
   void pushFront(const T& value) { emplaceFront_(value); }
   void pushFront(T&& value) { emplaceFront_(std::move(value)); }
 
+  // 作用：直接在块内槽位上用 args 构造新元素，返回新元素的引用。
+  template <class... Args>
+  T& emplaceBack(Args&&... args) {
+    return emplaceBack_(std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  T& emplaceFront(Args&&... args) {
+    return emplaceFront_(std::forward<Args>(args)...);
+  }
+
   void popBack() {
     assert(size_ > 0);
     decrementFinish_();
@@ -164,37 +482,45 @@ class SegmentedStorage {
   }
 
   //作用：在指定索引处插入一个新元素，返回新元素的索引。
-  size_type insertAt(size_type index, const T& value) {
+  size_type insertAt(size_type index, const T& value) { return emplaceAt(index, value); }
+  size_type insertAt(size_type index, T&& value) { return emplaceAt(index, std::move(value)); }
+
+  // 作用：在指定索引处用 args 构造新元素，返回新元素的索引。
+  // 两端直接在槽位上构造；中间位置只移动较短的一侧：靠近前端时整体左移，否则整体右移。
+  template <class... Args>
+  size_type emplaceAt(size_type index, Args&&... args) {
     assert(index <= size_);
     if (index == size_) {
-      pushBack(value);
+      emplaceBack_(std::forward<Args>(args)...);
       return size_ - 1;
     }
-    if (size_ == 0) {
-      pushBack(value);
+    if (index == 0) {
+      emplaceFront_(std::forward<Args>(args)...);
       return 0;
     }
 
-    //作用：在指定索引处插入一个新元素，返回新元素的索引。
-    pushBack(back());
-    for (size_type i = size_ - 1; i > index; --i) {
-      atIndex(i) = std::move(atIndex(i - 1));
+    // 中间位置在移动元素之前先构造出新值：args 可能引用容器内的元素，
+    // 而移动后腾出的槽位里是一个已被移走的对象。
+    T value(std::forward<Args>(args)...);
+    if (index < size_ / 2) {
+      pushFront(std::move(front()));
+      moveRange_(2, index + 1, 1);
+    } else {
+      pushBack(std::move(back()));
+      moveRangeBackward_(index, size_ - 2, size_ - 1);
     }
-    atIndex(index) = value;
+    atIndex(index) = std::move(value);
     return index;
   }
 
   //作用：在指定索引处删除一个元素，返回被删除元素的索引。
   size_type eraseAt(size_type index) {
     assert(index < size_);
-    for (size_type i = index; i + 1 < size_; ++i) {
-      atIndex(i) = std::move(atIndex(i + 1));
-    }
-    popBack();
-    return index;
+    return eraseRange(index, index + 1);
   }
 
   // 作用：删除指定范围内的元素，返回下一个元素的索引。
+  // 前面的元素较少时把前段右移并从前端弹出，否则把后段左移并从后端弹出。
   size_type eraseRange(size_type first, size_type last) {
     assert(first <= last);
     assert(last <= size_);
@@ -202,60 +528,191 @@ class SegmentedStorage {
     if (count == 0) {
       return first;
     }
-    for (size_type i = first; i + count < size_; ++i) {
-      atIndex(i) = std::move(atIndex(i + count));
-    }
-    for (size_type k = 0; k < count; ++k) {
-      popBack();
+    if (first < size_ - last) {
+      moveRangeBackward_(0, first, last);
+      popFrontN_(count);
+    } else {
+      moveRange_(last, size_, first);
+      popBackN_(count);
     }
     return first;
   }
+  // 作用：在指定索引处插入 [first, last)，返回第一个插入元素的索引。
+  // 前向迭代器一次性预留所需的块，再按块连续片段批量构造；
+  // 单趟输入迭代器先收集到临时存储中再走同一路径。
+  template <class InputIt>
+  size_type insertRange(size_type index, InputIt first, InputIt last) {
+    assert(index <= size_);
+    if constexpr (isForwardIterator_<InputIt>()) {
+      auto count = static_cast<size_type>(std::distance(first, last));
+      return insertRange_(index, first, count);
+    } else {
+      if (index == size_) {
+        for (; first != last; ++first) {
+          emplaceBack_(*first);
+        }
+        return index;
+      }
+      SegmentedStorage buffer(allocator_);
+      buffer.insertRange(0, first, last);
+      return insertRange_(index, std::make_move_iterator(buffer.begin()), buffer.size());
+    }
+  }
+
+  // 作用：在指定索引处插入 count 个 value 的副本，返回第一个插入元素的索引。
+  size_type insertFill(size_type index, size_type count, const T& value) {
+    assert(index <= size_);
+    // value 可能引用容器内的元素，先复制一份。
+    T copy(value);
+    if (index == size_) {
+      appendWith_(count, [this, &copy](T* dest, size_type n) { uninitializedFillN(allocator_, dest, n, copy); });
+      return index;
+    }
+    if (index == 0) {
+      prependWith_(count, [this, &copy](T* dest, size_type n) { uninitializedFillN(allocator_, dest, n, copy); });
+      return 0;
+    }
+    return insertRange_(index, RepeatIterator_{&copy, 0}, count);
+  }
 //作用：调整分段存储的大小。
   void resize(size_type count) {
     if (count < size_) {
-      while (size_ > count) {
-        popBack();
-      }
+      popBackN_(size_ - count);
       return;
     }
-    while (size_ < count) {
-      emplaceBack_(T{});
-    }
+    appendWith_(count - size_, [this](T* dest, size_type n) { uninitializedValueConstructN(allocator_, dest, n); });
   }
 
   void resize(size_type count, const T& value) {
     if (count < size_) {
-      while (size_ > count) {
-        popBack();
-      }
+      popBackN_(size_ - count);
       return;
     }
-    while (size_ < count) {
-      pushBack(value);
-    }
+    insertFill(size_, count - size_, value);
   }
 
   void assign(size_type count, const T& value) {
+    T copy(value);
     clear();
-    for (size_type i = 0; i < count; ++i) {
-      pushBack(value);
-    }
+    insertFill(0, count, copy);
   }
 // 作用：将指定范围内的元素赋值给分段存储。
   template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
   void assign(InputIt first, InputIt last) {
     clear();
-    for (auto it = first; it != last; ++it) {
-      pushBack(*it);
+    insertRange(0, first, last);
+  }
+
+  // 作用：把 [index, size) 拆分到一个新的存储中返回，自身保留 [0, index)。
+  // 新存储沿用同一分配器和块内偏移，index 之后的整块按指针转交，只有 index 所在的块需要搬移元素；
+  // index 恰好在块边界时连这一块也直接转交，自身换上一个空块作为 finish 块。
+  SegmentedStorage splitAt(size_type index) {
+    assert(index <= size_);
+    abortMigration_();
+    SegmentedStorage tail(allocator_);
+    tail.spare_limit_ = spare_limit_;
+    tail.growth_policy_ = growth_policy_;
+    if (index == size_) {
+      return tail;
+    }
+    if (index == 0) {
+      tail.adoptLayout_(*this);
+      return tail;
     }
+
+    Location split = locate_(index);
+    size_type last_block = lastAllocatedBlock_();
+    size_type used_count = last_block - split.block_index + 1;
+    // 映射数组一分配就挂到 tail 上，后面任何一步抛出异常都由 tail 的析构函数回收。
+    size_type capacity = tail.grownMapCapacity_(used_count);
+    size_type begin = tail.placeRun_(capacity, used_count, 0, false);
+    tail.map_ = tail.newMap_(capacity);
+    tail.map_capacity_ = capacity;
+
+    if (split.offset == 0) {
+      T* fresh = acquireBlock_();
+      tail.map_[begin] = map_[split.block_index];
+      map_[split.block_index] = fresh;
+      ++tail.stats_.blocks_spliced_in;
+      ++stats_.blocks_spliced_out;
+    } else {
+      T* boundary = tail.acquireBlock_();
+      tail.map_[begin] = boundary;
+      size_type end_offset = split.block_index == finish_block_ ? finish_offset_ : block_size;
+      relocateN_(elementPtr_(split.block_index, split.offset), end_offset - split.offset, boundary + split.offset);
+    }
+    for (size_type i = split.block_index + 1; i <= last_block; ++i) {
+      tail.map_[begin + (i - split.block_index)] = map_[i];
+      map_[i] = nullptr;
+    }
+    tail.stats_.blocks_spliced_in += last_block - split.block_index;
+    stats_.blocks_spliced_out += last_block - split.block_index;
+
+    tail.start_block_ = begin;
+    tail.start_offset_ = split.offset;
+    tail.finish_block_ = begin + (finish_block_ - split.block_index);
+    tail.finish_offset_ = finish_offset_;
+    tail.size_ = size_ - index;
+
+    finish_block_ = split.block_index;
+    finish_offset_ = split.offset;
+    size_ = index;
+    return tail;
   }
 
- private:
-  struct Location {
-    size_type block_index;
-    size_type offset;
-  };
+  // 作用：把 other 的全部元素接到末尾，other 变为未分配的空状态。
+  // 分配器相等且 other 的起点与自身 finish 的块内偏移一致时按指针转交整块，只搬移交界块中较少的一侧；
+  // 偏移不一致时整块转交无法保持下标连续，改为把较短的一方逐个移动到另一方，再接管其块。
+  void appendSplice(SegmentedStorage&& other) {
+    assert(this != &other);
+    if (other.size_ == 0) {
+      return;
+    }
+    if (!(allocator_ == other.allocator_)) {
+      auto source = std::make_move_iterator(other.begin());
+      appendWith_(other.size_, copier_(source));
+      other.resetEmpty_();
+    } else if (size_ == 0) {
+      adoptLayout_(other);
+    } else if (other.start_offset_ == finish_offset_) {
+      concatAligned_(*this, other);
+    } else if (other.size_ <= size_) {
+      auto source = std::make_move_iterator(other.begin());
+      appendWith_(other.size_, copier_(source));
+      other.resetEmpty_();
+    } else {
+      auto source = std::make_move_iterator(begin());
+      other.prependWith_(size_, other.copier_(source));
+      adoptLayout_(other);
+    }
+  }
+
+  // 作用：把 other 的全部元素接到前端，other 变为未分配的空状态；规则与 appendSplice 对称。
+  void prependSplice(SegmentedStorage&& other) {
+    assert(this != &other);
+    if (other.size_ == 0) {
+      return;
+    }
+    if (!(allocator_ == other.allocator_)) {
+      auto source = std::make_move_iterator(other.begin());
+      prependWith_(other.size_, copier_(source));
+      other.resetEmpty_();
+    } else if (size_ == 0) {
+      adoptLayout_(other);
+    } else if (other.finish_offset_ == start_offset_) {
+      concatAligned_(other, *this);
+    } else if (other.size_ <= size_) {
+      auto source = std::make_move_iterator(other.begin());
+      prependWith_(other.size_, copier_(source));
+      other.resetEmpty_();
+    } else {
+      auto source = std::make_move_iterator(begin());
+      other.appendWith_(size_, other.copier_(source));
+      adoptLayout_(other);
+    }
+  }
 
+ private:
   T** map_ = nullptr;
   size_type map_capacity_ = 0;
 
@@ -267,14 +724,232 @@ class SegmentedStorage {
 
   size_type size_ = 0;
 
+  // 空闲块以侵入式单链表串起来：链接指针直接写在块的原始内存里，不需要额外分配。
+  T* spare_head_ = nullptr;
+  size_type spare_count_ = 0;
+  size_type spare_limit_ = default_spare_block_limit;
+
+  MapGrowthPolicy growth_policy_{};
+  BlockStats stats_{};
+
+  // 增量增长时提前分配的下一个映射数组：槽位 [0, next_filled_) 已经写好，
+  // 旧映射数组的槽位 i 对应新映射数组的槽位 i + next_shift_。没有进行中的搬移时 next_map_ 为空。
+  T** next_map_ = nullptr;
+  size_type next_capacity_ = 0;
+  size_type next_filled_ = 0;
+  difference_type next_shift_ = 0;
+
   allocator_type allocator_{};
+
+  static_assert(sizeof(T) * block_size >= sizeof(T*), "block too small to hold the spare-list link");
+
+  using propagate_on_copy_assignment = typename allocator_traits::propagate_on_container_copy_assignment;
+  using propagate_on_move_assignment = typename allocator_traits::propagate_on_container_move_assignment;
+// 作用：交换除分配器之外的全部状态（映射数组、游标、空闲块缓存、增长策略、统计与进行中的搬移）。
+  void swapContents_(SegmentedStorage& other) noexcept {
+    using std::swap;
+    swap(map_, other.map_);
+    swap(map_capacity_, other.map_capacity_);
+    swap(start_block_, other.start_block_);
+    swap(start_offset_, other.start_offset_);
+    swap(finish_block_, other.finish_block_);
+    swap(finish_offset_, other.finish_offset_);
+    swap(size_, other.size_);
+    swap(spare_head_, other.spare_head_);
+    swap(spare_count_, other.spare_count_);
+    swap(spare_limit_, other.spare_limit_);
+    swap(growth_policy_, other.growth_policy_);
+    swap(stats_, other.stats_);
+    swap(next_map_, other.next_map_);
+    swap(next_capacity_, other.next_capacity_);
+    swap(next_filled_, other.next_filled_);
+    swap(next_shift_, other.next_shift_);
+  }
+// 作用：交换分配器，只在对应的 propagate_on_container_* 特性为真时调用。
+  void swapAllocators_(SegmentedStorage& other) noexcept {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+    swap(map_allocator_, other.map_allocator_);
+  }
+
+  template <class It>
+  static constexpr bool isForwardIterator_() {
+    return std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+  }
+
+  // 把同一个值重复 count 次的前向迭代器，用于 insertFill 复用区间插入的逻辑。
+  struct RepeatIterator_ {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const T* value;
+    size_type index;
+
+    reference operator*() const { return *value; }
+    pointer operator->() const { return value; }
+    RepeatIterator_& operator++() {
+      ++index;
+      return *this;
+    }
+    RepeatIterator_ operator++(int) {
+      RepeatIterator_ tmp = *this;
+      ++index;
+      return tmp;
+    }
+    bool operator==(const RepeatIterator_& other) const { return index == other.index; }
+    bool operator!=(const RepeatIterator_& other) const { return index != other.index; }
+  };
+
+  template <class ForwardIt>
+  auto copier_(ForwardIt& it) {
+    return [this, &it](T* dest, size_type n) { it = uninitializedCopyN(allocator_, it, n, dest); };
+  }
+// 作用：在中间位置插入 count 个来自 first 的元素；移动较短的一侧。
+  // 先用较短一侧的元素（移动）或新元素构造出新的槽位，再把剩余部分赋值到空出的位置。
+  template <class ForwardIt>
+  size_type insertRange_(size_type index, ForwardIt first, size_type count) {
+    if (count == 0) {
+      return index;
+    }
+    if (index == size_) {
+      appendWith_(count, copier_(first));
+      return index;
+    }
+    if (index == 0) {
+      prependWith_(count, copier_(first));
+      return 0;
+    }
+
+    size_type elems_after = size_ - index;
+    if (index < elems_after) {
+      // 预留之后映射数组不再变化，下面取得的内部迭代器保持有效。
+      reserveFrontSlots_(count);
+      auto old_front = std::make_move_iterator(begin());
+      if (index >= count) {
+        prependWith_(count, copier_(old_front));
+        moveRange_(2 * count, index + count, count);
+        std::copy_n(first, count, iterator(this, index));
+      } else {
+        ForwardIt mid = std::next(first, static_cast<difference_type>(count - index));
+        ForwardIt head = first;
+        prependWith_(count - index, copier_(head));
+        prependWith_(index, copier_(old_front));
+        std::copy_n(mid, index, iterator(this, count));
+      }
+    } else {
+      reserveBackSlots_(count);
+      size_type old_size = size_;
+      if (elems_after >= count) {
+        auto old_tail = std::make_move_iterator(iterator(this, old_size - count));
+        appendWith_(count, copier_(old_tail));
+        moveRangeBackward_(index, old_size - count, old_size);
+        std::copy_n(first, count, iterator(this, index));
+      } else {
+        ForwardIt mid = std::next(first, static_cast<difference_type>(elems_after));
+        ForwardIt tail = mid;
+        auto old_tail = std::make_move_iterator(iterator(this, index));
+        appendWith_(count - elems_after, copier_(tail));
+        appendWith_(elems_after, copier_(old_tail));
+        std::copy(first, mid, iterator(this, index));
+      }
+    }
+    return index;
+  }
+// 作用：确保末尾还能容纳 count 个元素：一次性扩展映射数组并分配所有需要的块。
+  void reserveBackSlots_(size_type count) {
+    ensureMap_();
+    size_type extra_blocks = (finish_offset_ + count) / block_size;
+    reserveMap_(extra_blocks, false);
+    for (size_type i = 1; i <= extra_blocks; ++i) {
+      allocateBlockIfNeeded_(finish_block_ + i);
+    }
+  }
+// 作用：确保前端还能容纳 count 个元素：一次性扩展映射数组并分配所有需要的块。
+  void reserveFrontSlots_(size_type count) {
+    ensureMap_();
+    size_type extra_blocks = count > start_offset_ ? (count - start_offset_ + block_size - 1) / block_size : 0;
+    reserveMap_(extra_blocks, true);
+    for (size_type i = 1; i <= extra_blocks; ++i) {
+      allocateBlockIfNeeded_(start_block_ - i);
+    }
+  }
+// 作用：在末尾追加 count 个元素，construct(dest, n) 负责在一段块内连续槽位上构造 n 个元素。
+  // 构造失败时撤销本次追加的所有元素。
+  template <class ConstructFn>
+  void appendWith_(size_type count, ConstructFn construct) {
+    if (count == 0) {
+      return;
+    }
+    reserveBackSlots_(count);
+    size_type old_size = size_;
+    size_type old_finish_block = finish_block_;
+    try {
+      while (count > 0) {
+        size_type chunk = std::min(count, block_size - finish_offset_);
+        construct(elementPtr_(finish_block_, finish_offset_), chunk);
+        finish_offset_ += chunk;
+        size_ += chunk;
+        if (finish_offset_ == block_size) {
+          finish_offset_ = 0;
+          ++finish_block_;
+        }
+        count -= chunk;
+      }
+    } catch (...) {
+      popBackN_(size_ - old_size);
+      throw;
+    }
+    stats_.blocks_pushed_back += finish_block_ - old_finish_block;
+  }
+// 作用：在前端插入 count 个元素，按正序从新的起点开始逐块构造，全部成功后才移动 start。
+  template <class ConstructFn>
+  void prependWith_(size_type count, ConstructFn construct) {
+    if (count == 0) {
+      return;
+    }
+    reserveFrontSlots_(count);
+    size_type absolute = start_block_ * block_size + start_offset_ - count;
+    size_type new_block = absolute / block_size;
+    size_type new_offset = absolute % block_size;
+
+    size_type block_index = new_block;
+    size_type offset = new_offset;
+    size_type constructed = 0;
+    try {
+      while (constructed < count) {
+        size_type chunk = std::min(count - constructed, block_size - offset);
+        construct(elementPtr_(block_index, offset), chunk);
+        constructed += chunk;
+        offset += chunk;
+        if (offset == block_size) {
+          offset = 0;
+          ++block_index;
+        }
+      }
+    } catch (...) {
+      block_index = new_block;
+      offset = new_offset;
+      while (constructed > 0) {
+        size_type chunk = std::min(constructed, block_size - offset);
+        destroyN(allocator_, elementPtr_(block_index, offset), chunk);
+        constructed -= chunk;
+        offset = 0;
+        ++block_index;
+      }
+      throw;
+    }
+    stats_.blocks_pushed_front += start_block_ - new_block;
+    start_block_ = new_block;
+    start_offset_ = new_offset;
+    size_ += count;
+  }
 // 作用：初始化一个空的分段存储结构，设置初始的块和偏移量。
   void initEmpty_() {
-    map_capacity_ = 8;
-    map_ = map_allocator_traits::allocate(map_allocator_, map_capacity_);
-    for (size_type i = 0; i < map_capacity_; ++i) {
-      map_[i] = nullptr;
-    }
+    map_ = newMap_(initial_map_capacity);
+    map_capacity_ = initial_map_capacity;
 
     start_block_ = map_capacity_ / 2;
     finish_block_ = start_block_;
@@ -285,19 +960,18 @@ class SegmentedStorage {
     finish_offset_ = start_offset_;
     size_ = 0;
   }
-// 作用：重置分段存储到中心位置，释放所有块和映射。
-  void resetToCenter_() {
-    // Destroyed already, so only deallocate blocks and reinit
-    freeAllBlocks_();
-    freeMap_();
-    initEmpty_();
+// 作用：尚未分配映射数组时先完成初始化，保证游标指向一个已分配的中心块。
+  void ensureMap_() {
+    if (map_ == nullptr) {
+      initEmpty_();
+    }
   }
 
   void destroyAll_() noexcept {
     // Destroy in logical order to avoid double-destruction hazards.
-    for (size_type i = 0; i < size_; ++i) {
-      auto [block_index, offset] = locate_(i);
-      destroyAt(allocator_, elementPtr_(block_index, offset));
+    // 平凡可析构的元素不需要逐个析构，直接复位游标。
+    if constexpr (!is_trivially_destroyable_v<allocator_type, T>) {
+      forEachSegment_(0, size_, [this](T* ptr, size_type count) { destroyN(allocator_, ptr, count); });
     }
     size_ = 0;
     finish_block_ = start_block_;
@@ -305,18 +979,65 @@ class SegmentedStorage {
   }
 
   void freeAllBlocks_() noexcept {
+    while (spare_head_ != nullptr) {
+      deallocateBlock_(popSpare_());
+    }
     if (map_ == nullptr) {
       return;
     }
     for (size_type i = 0; i < map_capacity_; ++i) {
       if (map_[i] != nullptr) {
-        deallocateBlock(allocator_, map_[i], block_size);
+        deallocateBlock_(map_[i]);
         map_[i] = nullptr;
       }
     }
   }
 
+  void deallocateBlock_(T* block) noexcept {
+    deallocateBlock(allocator_, block, block_size);
+    ++stats_.block_deallocations;
+  }
+
+  static T* nextSpare_(T* block) noexcept {
+    T* next = nullptr;
+    std::memcpy(&next, static_cast<const void*>(block), sizeof(next));
+    return next;
+  }
+
+  T* popSpare_() noexcept {
+    assert(spare_head_ != nullptr);
+    T* block = spare_head_;
+    spare_head_ = nextSpare_(block);
+    --spare_count_;
+    return block;
+  }
+// 作用：获取一个块，优先复用空闲缓存中的块，缓存为空时才向分配器申请。
+  T* acquireBlock_() {
+    if (spare_head_ != nullptr) {
+      ++stats_.block_reuses;
+      return popSpare_();
+    }
+    T* block = allocateBlock(allocator_, block_size);
+    ++stats_.block_allocations;
+    return block;
+  }
+// 作用：归还一个已不含元素的块；缓存未达上限时放入缓存，否则释放。
+  void releaseBlock_(T* block) noexcept {
+    if (spare_count_ < spare_limit_) {
+      cacheBlock_(block);
+      return;
+    }
+    deallocateBlock_(block);
+  }
+// 作用：把块挂到空闲缓存链表头部，链接指针就存放在块自身的前几个字节中。
+  void cacheBlock_(T* block) noexcept {
+    std::memcpy(static_cast<void*>(block), &spare_head_, sizeof(spare_head_));
+    spare_head_ = block;
+    ++spare_count_;
+  }
+
   void freeMap_() noexcept {
+    abortMigration_();
     if (map_ == nullptr) {
       return;
     }
@@ -324,56 +1045,494 @@ class SegmentedStorage {
     map_ = nullptr;
     map_capacity_ = 0;
   }
-// 作用：如果指定的块索引处没有分配块，则分配一个新块。
-  void allocateBlockIfNeeded_(size_type block_index) {
+// 作用：分配一个容量为 capacity、所有槽位置空的映射数组。
+  T** newMap_(size_type capacity) {
+    T** map = map_allocator_traits::allocate(map_allocator_, capacity);
+    ++stats_.map_allocations;
+    for (size_type i = 0; i < capacity; ++i) {
+      map[i] = nullptr;
+    }
+    return map;
+  }
+// 作用：销毁全部元素，映射数组上的块按缓存上限归还，再释放映射数组，回到未分配的空状态。
+  void resetEmpty_() noexcept {
+    destroyAll_();
+    if (map_ != nullptr) {
+      for (size_type i = 0; i < map_capacity_; ++i) {
+        if (map_[i] != nullptr) {
+          releaseBlockAt_(i);
+        }
+      }
+      freeMap_();
+    }
+    start_block_ = 0;
+    start_offset_ = 0;
+    finish_block_ = 0;
+    finish_offset_ = 0;
+  }
+// 作用：丢弃自身的元素后原样接管 other 的映射数组、块与游标，other 回到未分配的空状态。
+  // 要求两者的分配器相等；空闲块缓存、增长策略和统计各自保留。
+  void adoptLayout_(SegmentedStorage& other) noexcept {
+    assert(allocator_ == other.allocator_);
+    resetEmpty_();
+    other.abortMigration_();
+    size_type blocks = 0;
+    for (size_type i = 0; i < other.map_capacity_; ++i) {
+      blocks += other.map_[i] != nullptr ? 1 : 0;
+    }
+    stats_.blocks_spliced_in += blocks;
+    other.stats_.blocks_spliced_out += blocks;
+
+    map_ = std::exchange(other.map_, nullptr);
+    map_capacity_ = std::exchange(other.map_capacity_, 0);
+    start_block_ = std::exchange(other.start_block_, 0);
+    start_offset_ = std::exchange(other.start_offset_, 0);
+    finish_block_ = std::exchange(other.finish_block_, 0);
+    finish_offset_ = std::exchange(other.finish_offset_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+// 作用：把 src 起的 count 个元素移动构造到未初始化的 dest，再析构源元素；失败时已构造的目标元素被销毁。
+  void relocateN_(T* src, size_type count, T* dest) {
+    if constexpr (is_bitwise_copyable_v<allocator_type, T>) {
+      uninitializedCopyN(allocator_, static_cast<const T*>(src), count, dest);
+    } else {
+      uninitializedCopyN(allocator_, std::make_move_iterator(src), count, dest);
+    }
+    destroyN(allocator_, src, count);
+  }
+// 作用：front 在前、back 在后拼接到 *this（*this 是两者之一），另一个回到未分配的空状态。
+  // 要求两者都非空、分配器相等，且 front 的 finish 与 back 的起点块内偏移相同：
+  // 交界处两个半满的块合成一个，只搬移其中较少的一侧元素，其余的块按指针放进新的映射数组。
+  void concatAligned_(SegmentedStorage& front, SegmentedStorage& back) {
+    assert(this == &front || this == &back);
+    assert(front.size_ > 0 && back.size_ > 0);
+    assert(front.finish_offset_ == back.start_offset_);
+    SegmentedStorage& other = this == &front ? back : front;
+    front.abortMigration_();
+    back.abortMigration_();
+
+    // 新映射数组依次放入：front 的前端预留块和 finish 之前的块、交界块、back 起点之后的块和末尾预留块。
+    // front 末尾的预留块与 back 前端的预留块留在原处，随原映射数组一起归还。
+    size_type front_first = front.firstAllocatedBlock_();
+    size_type back_last = back.lastAllocatedBlock_();
+    size_type front_count = front.finish_block_ - front_first;
+    size_type back_count = back_last - back.start_block_;
+    size_type used_count = front_count + 1 + back_count;
+    size_type new_capacity = grownMapCapacity_(used_count);
+    size_type new_begin = placeRun_(new_capacity, used_count, 0, false);
+    T** new_map = newMap_(new_capacity);
+
+    // 交界块：front 的 finish 块持有 [front_begin, split)，back 的起点块持有 [split, back_end)；
+    // front 只有一个块时 front_begin 是它的起点偏移，否则为 0。
+    size_type front_begin = front.start_block_ == front.finish_block_ ? front.start_offset_ : 0;
+    size_type split = front.finish_offset_;
+    size_type back_end = back.start_block_ == back.finish_block_ ? back.finish_offset_ : block_size;
+    T* front_block = front.map_[front.finish_block_];
+    T* back_block = back.map_[back.start_block_];
+    bool keep_back_block = split - front_begin <= back_end - split;
+    try {
+      if (keep_back_block) {
+        relocateN_(front_block + front_begin, split - front_begin, back_block + front_begin);
+      } else {
+        relocateN_(back_block + split, back_end - split, front_block + split);
+      }
+    } catch (...) {
+      map_allocator_traits::deallocate(map_allocator_, new_map, new_capacity);
+      throw;
+    }
+    front.map_[front.finish_block_] = nullptr;
+    back.map_[back.start_block_] = nullptr;
+    if (keep_back_block) {
+      front.releaseBlock_(front_block);
+    } else {
+      back.releaseBlock_(back_block);
+    }
+
+    for (size_type i = 0; i < front_count; ++i) {
+      new_map[new_begin + i] = std::exchange(front.map_[front_first + i], nullptr);
+    }
+    new_map[new_begin + front_count] = keep_back_block ? back_block : front_block;
+    for (size_type i = 1; i <= back_count; ++i) {
+      new_map[new_begin + front_count + i] = std::exchange(back.map_[back.start_block_ + i], nullptr);
+    }
+    bool junction_from_other = (&other == &back) == keep_back_block;
+    size_type transferred = (&other == &front ? front_count : back_count) + (junction_from_other ? 1 : 0);
+    stats_.blocks_spliced_in += transferred;
+    other.stats_.blocks_spliced_out += transferred;
+
+    size_type start_block = new_begin + (front.start_block_ - front_first);
+    size_type start_offset = front.start_offset_;
+    size_type finish_block = new_begin + front_count + (back.finish_block_ - back.start_block_);
+    size_type finish_offset = back.finish_offset_;
+    size_type size = front.size_ + back.size_;
+
+    // 元素都已挂到新映射数组上，两边只剩不再使用的块和旧映射数组。
+    front.size_ = 0;
+    back.size_ = 0;
+    other.resetEmpty_();
+    resetEmpty_();
+    map_ = new_map;
+    map_capacity_ = new_capacity;
+    start_block_ = start_block;
+    start_offset_ = start_offset;
+    finish_block_ = finish_block;
+    finish_offset_ = finish_offset;
+    size_ = size;
+  }
+// 作用：如果指定的块索引处没有分配块，则分配一个新块；返回是否新挂上了块（已有预留块时为 false）。
+  bool allocateBlockIfNeeded_(size_type block_index) {
     assert(block_index < map_capacity_);
     if (map_[block_index] == nullptr) {
-      map_[block_index] = allocateBlock(allocator_, block_size);
+      map_[block_index] = acquireBlock_();
+      if (next_map_ != nullptr) {
+        mirrorSlot_(block_index);
+      }
+      return true;
+    }
+    return false;
+  }
+// 作用：把已经腾空的块从映射数组中摘下并归还。
+  // 不变式：已分配的块在映射数组中连续，即 [start_block_, finish_block_] 加上两侧紧邻的预留块，
+  // 其余槽位始终为空。
+  void releaseBlockAt_(size_type block_index) noexcept {
+    assert(block_index < map_capacity_);
+    releaseBlock_(map_[block_index]);
+    map_[block_index] = nullptr;
+    if (next_map_ != nullptr) {
+      mirrorSlot_(block_index);
+    }
+  }
+// 作用：归还末尾刚腾空的块 block_index。其后还有预留块时改为归还最外侧的预留块，
+  // 腾空的块接替它，已分配的块保持连续，末尾的预留容量也不变。
+  void releaseBackBlock_(size_type block_index) noexcept {
+    size_type last = block_index;
+    while (last + 1 < map_capacity_ && map_[last + 1] != nullptr) {
+      ++last;
+    }
+    releaseBlockAt_(last);
+  }
+// 作用：归还前端刚腾空的块 block_index，规则与 releaseBackBlock_ 对称。
+  void releaseFrontBlock_(size_type block_index) noexcept {
+    size_type first = block_index;
+    while (first > 0 && map_[first - 1] != nullptr) {
+      --first;
+    }
+    releaseBlockAt_(first);
+  }
+// 作用：返回连续已分配块的第一个块索引（包含前端预留块）。
+  size_type firstAllocatedBlock_() const noexcept {
+    size_type first = start_block_;
+    while (first > 0 && map_[first - 1] != nullptr) {
+      --first;
+    }
+    return first;
+  }
+// 作用：返回连续已分配块的最后一个块索引（包含末尾预留块）。
+  size_type lastAllocatedBlock_() const noexcept {
+    size_type last = finish_block_;
+    while (last + 1 < map_capacity_ && map_[last + 1] != nullptr) {
+      ++last;
+    }
+    return last;
+  }
+// 作用：归还 [start_block_, finish_block_] 之外仍挂在映射数组上的块（即全部预留块）。
+  void releaseOutOfRange_() noexcept {
+    for (size_type i = 0; i < start_block_; ++i) {
+      if (map_[i] != nullptr) {
+        releaseBlockAt_(i);
+      }
+    }
+    for (size_type i = finish_block_ + 1; i < map_capacity_; ++i) {
+      if (map_[i] != nullptr) {
+        releaseBlockAt_(i);
+      }
     }
   }
 // 作用：根据需要扩展映射数组，以便在前端或后端插入新块。
+  // 增量增长时先推进进行中的搬移，正常情况下 reserveMap_ 随后直接返回。
   void growMapIfNeeded_(bool grow_front) {
+    if (growth_policy_.incremental && map_ != nullptr) {
+      stepMigration_(grow_front);
+    }
+    reserveMap_(1, grow_front);
+  }
+// 作用：增量增长的单步：有进行中的搬移时写入 incremental_map_step 个新槽位；
+  // 否则在这次推入要跨进新块、且增长的一端空槽位不足以等到一轮搬移完成时，开始新的一轮。
+  void stepMigration_(bool grow_front) {
+    if (next_map_ != nullptr) {
+      migrateSlots_(incremental_map_step);
+      return;
+    }
+    bool crossing = grow_front ? start_offset_ == 0 : finish_offset_ + 1 == block_size;
+    if (!crossing) {
+      return;
+    }
+    size_type free_slots = grow_front ? start_block_ : map_capacity_ - 1 - finish_block_;
+    if (free_slots < migrationThreshold_(finish_block_ - start_block_ + 1)) {
+      beginMigration_(grow_front);
+    }
+  }
+// 作用：增量增长时新映射数组在增长的一端至少留出的空槽位数。
+  static constexpr size_type migrationHeadroom_(size_type used_count) noexcept { return used_count / 4 + 4; }
+// 作用：增长的一端空槽位少于这个数时开始搬移。一轮搬移写满容量为 capacity 的新映射数组
+  // 需要 capacity / incremental_map_step 次推入，其间最多跨进这么多块再除以 block_size 个块。
+  size_type migrationThreshold_(size_type used_count) const noexcept {
+    size_type capacity = grownMapCapacity_(used_count + migrationHeadroom_(used_count));
+    return capacity / (incremental_map_step * block_size) + 3;
+  }
+// 作用：分配下一个映射数组并确定新旧槽位的对应关系，槽位留到之后的推入中逐步写入。
+  // 新映射数组不预先置空：写入时连同空槽位一起按顺序填写，分配本身之外没有与容量成正比的工作。
+  void beginMigration_(bool grow_front) {
+    size_type first_block = firstAllocatedBlock_();
+    size_type used_count = (lastAllocatedBlock_() - first_block) + 1;
+    size_type headroom = migrationHeadroom_(used_count);
+    size_type capacity = grownMapCapacity_(used_count + headroom);
+    size_type new_begin = placeRun_(capacity, used_count, headroom, grow_front);
+    next_map_ = map_allocator_traits::allocate(map_allocator_, capacity);
+    ++stats_.map_allocations;
+    next_capacity_ = capacity;
+    next_filled_ = 0;
+    next_shift_ = static_cast<difference_type>(new_begin) - static_cast<difference_type>(first_block);
+  }
+// 作用：按顺序再写入最多 count 个新槽位，取自旧映射数组的对应槽位（超出旧映射数组的为空）；
+  // 全部写完后切换到新映射数组。
+  void migrateSlots_(size_type count) noexcept {
+    size_type end = std::min(next_capacity_, next_filled_ + count);
+    auto old_capacity = static_cast<difference_type>(map_capacity_);
+    for (; next_filled_ < end; ++next_filled_) {
+      difference_type old_index = static_cast<difference_type>(next_filled_) - next_shift_;
+      next_map_[next_filled_] = old_index >= 0 && old_index < old_capacity ? map_[old_index] : nullptr;
+    }
+    if (next_filled_ == next_capacity_) {
+      map_allocator_traits::deallocate(map_allocator_, map_, map_capacity_);
+      map_ = std::exchange(next_map_, nullptr);
+      map_capacity_ = std::exchange(next_capacity_, 0);
+      start_block_ = static_cast<size_type>(static_cast<difference_type>(start_block_) + next_shift_);
+      finish_block_ = static_cast<size_type>(static_cast<difference_type>(finish_block_) + next_shift_);
+      next_filled_ = 0;
+      next_shift_ = 0;
+      ++stats_.map_migrations;
+    }
+  }
+// 作用：搬移期间旧映射数组的槽位 block_index 发生变化时，同步到已经写好的对应新槽位；
+  // 新挂上的块落在新映射数组范围之外时放弃这一轮搬移，之后的推入会重新开始。
+  void mirrorSlot_(size_type block_index) noexcept {
+    difference_type target = static_cast<difference_type>(block_index) + next_shift_;
+    if (target < 0 || target >= static_cast<difference_type>(next_capacity_)) {
+      if (map_[block_index] != nullptr) {
+        abortMigration_();
+      }
+      return;
+    }
+    if (static_cast<size_type>(target) < next_filled_) {
+      next_map_[target] = map_[block_index];
+    }
+  }
+// 作用：放弃进行中的搬移，归还提前分配的映射数组；旧映射数组始终完整，不需要回滚。
+  // 除推入与弹出之外直接改写映射数组的操作都先调用它。
+  void abortMigration_() noexcept {
+    if (next_map_ == nullptr) {
+      return;
+    }
+    map_allocator_traits::deallocate(map_allocator_, next_map_, next_capacity_);
+    next_map_ = nullptr;
+    next_capacity_ = 0;
+    next_filled_ = 0;
+    next_shift_ = 0;
+  }
+// 作用：确保映射数组在前端（grow_front）或后端还有 extra_blocks 个空槽位。
+  void reserveMap_(size_type extra_blocks, bool grow_front) {
     if (!grow_front) {
-      if (finish_block_ + 1 < map_capacity_) {
+      if (finish_block_ + extra_blocks < map_capacity_) {
         return;
       }
     } else {
-      if (start_block_ > 0) {
+      if (start_block_ >= extra_blocks) {
         return;
       }
     }
 
-    size_type new_capacity = map_capacity_ * 2;
-    T** new_map = map_allocator_traits::allocate(map_allocator_, new_capacity);
-    for (size_type i = 0; i < new_capacity; ++i) {
-      new_map[i] = nullptr;
+    // 惰性分配：第一次插入走到这里时才建立映射数组和中心块，然后按新的游标重新检查。
+    if (map_ == nullptr) {
+      initEmpty_();
+      reserveMap_(extra_blocks, grow_front);
+      return;
+    }
+
+    // 增量搬移来不及完成（例如推入方向改变、或批量插入一次要很多槽位）时一次写完剩余槽位，
+    // 切换后新映射数组可能已经够用。
+    if (next_map_ != nullptr) {
+      migrateSlots_(next_capacity_);
+      reserveMap_(extra_blocks, grow_front);
+      return;
     }
 
-    // 作用
-    size_type used_begin = start_block_;
-    size_type used_end = finish_block_;
-    size_type used_count = (used_end - used_begin) + 1;
+    // 预留块与使用中的块一起搬移，映射数组重新分配或居中后预留容量不变。
+    size_type first_block = firstAllocatedBlock_();
+    size_type last_block = lastAllocatedBlock_();
+    size_type used_count = (last_block - first_block) + 1;
+    size_type needed = used_count + extra_blocks;
+
+    // 映射数组足够稀疏时原地搬移，避免在 FIFO 稳态下反复分配新的映射数组。
+    if (growth_policy_.recenter_in_place && map_capacity_ >= 2 * needed) {
+      size_type new_begin = placeRun_(map_capacity_, used_count, extra_blocks, grow_front);
+      ++stats_.map_recenters;
+      if (new_begin < first_block) {
+        std::rotate(map_ + new_begin, map_ + first_block, map_ + last_block + 1);
+      } else {
+        std::rotate(map_ + first_block, map_ + last_block + 1, map_ + new_begin + used_count);
+      }
+      start_block_ = start_block_ - first_block + new_begin;
+      finish_block_ = finish_block_ - first_block + new_begin;
+      return;
+    }
 
-    size_type new_begin = (new_capacity - used_count) / 2;
+    size_type new_capacity = grownMapCapacity_(needed);
+    relocateMap_(new_capacity, placeRun_(new_capacity, used_count, extra_blocks, grow_front));
+  }
+// 作用：按增长倍数计算重新分配后的映射数组容量，至少能放下 needed 个槽位再加两端各一个空槽。
+  // 映射数组本身已经稀疏（只是不允许原地搬移）时按 needed 计算，避免 FIFO 负载下容量无限翻倍。
+  size_type grownMapCapacity_(size_type needed) const noexcept {
+    size_type base = map_capacity_ >= 2 * needed ? needed : std::max(map_capacity_, needed);
+    double grown = static_cast<double>(base) * growth_policy_.growth_factor;
+    return std::max(static_cast<size_type>(grown), needed + 2);
+  }
+// 作用：计算 used_count 个连续已分配块在容量为 capacity 的映射数组中的起始槽位（即前端空闲槽位数）。
+  // 默认两端平分空闲槽位；bias_to_hot_end 时按两端推入块数的比例分配，冷端至少保留 cold_end_share。
+  // 请求增长的一端无论如何都至少留出 extra_blocks 个空槽位。
+  size_type placeRun_(size_type capacity, size_type used_count, size_type extra_blocks, bool grow_front) const noexcept {
+    assert(capacity >= used_count + extra_blocks);
+    size_type free_slots = capacity - used_count;
+    size_type front_free = free_slots / 2;
+    if (growth_policy_.bias_to_hot_end) {
+      // 加一平滑：还没有统计数据时退化为平分。
+      double back = static_cast<double>(stats_.blocks_pushed_back) + 1;
+      double front = static_cast<double>(stats_.blocks_pushed_front) + 1;
+      double front_share = std::clamp(front / (back + front), cold_end_share, 1.0 - cold_end_share);
+      front_free = static_cast<size_type>(static_cast<double>(free_slots) * front_share);
+    }
+    if (grow_front) {
+      return std::max(front_free, extra_blocks);
+    }
+    return std::min(front_free, free_slots - extra_blocks);
+  }
+// 作用：把连续的已分配块（含预留块）搬到容量为 new_capacity 的新映射数组中，从槽位 new_begin 开始存放。
+  void relocateMap_(size_type new_capacity, size_type new_begin) {
+    abortMigration_();
+    size_type first_block = firstAllocatedBlock_();
+    size_type last_block = lastAllocatedBlock_();
+    size_type used_count = (last_block - first_block) + 1;
+    assert(new_capacity >= used_count + 2);
+    T** new_map = newMap_(new_capacity);
+
+    assert(new_begin + used_count <= new_capacity);
     for (size_type i = 0; i < used_count; ++i) {
-      new_map[new_begin + i] = map_[used_begin + i];
+      new_map[new_begin + i] = map_[first_block + i];
     }
 
     map_allocator_traits::deallocate(map_allocator_, map_, map_capacity_);
 
-    start_block_ = new_begin;
-    finish_block_ = new_begin + used_count - 1;
+    start_block_ = start_block_ - first_block + new_begin;
+    finish_block_ = finish_block_ - first_block + new_begin;
 
     map_ = new_map;
     map_capacity_ = new_capacity;
   }
+// 作用：对逻辑区间 [first, last) 按块拆成若干连续片段，依次调用 fn(ptr, count)。
+  template <class Fn>
+  void forEachSegment_(size_type first, size_type last, Fn&& fn) const {
+    while (first < last) {
+      Location location = locate_(first);
+      size_type chunk = std::min(last - first, block_size - location.offset);
+      fn(elementPtr_(location.block_index, location.offset), chunk);
+      first += chunk;
+    }
+  }
+// 作用：从末尾批量删除 count 个元素，逐块析构并归还腾空的块。
+  void popBackN_(size_type count) noexcept {
+    assert(count <= size_);
+    while (count > 0) {
+      if (finish_offset_ == 0) {
+        --finish_block_;
+        finish_offset_ = block_size;
+        releaseBackBlock_(finish_block_ + 1);
+      }
+      size_type chunk = std::min(count, finish_offset_);
+      finish_offset_ -= chunk;
+      destroyN(allocator_, elementPtr_(finish_block_, finish_offset_), chunk);
+      size_ -= chunk;
+      count -= chunk;
+    }
+    if (size_ == 0) {
+      start_block_ = finish_block_;
+      start_offset_ = finish_offset_;
+    }
+  }
+// 作用：从前端批量删除 count 个元素，逐块析构并归还腾空的块。
+  void popFrontN_(size_type count) noexcept {
+    assert(count <= size_);
+    while (count > 0) {
+      size_type chunk = std::min(count, block_size - start_offset_);
+      destroyN(allocator_, elementPtr_(start_block_, start_offset_), chunk);
+      start_offset_ += chunk;
+      size_ -= chunk;
+      count -= chunk;
+      if (start_offset_ == block_size) {
+        start_offset_ = 0;
+        ++start_block_;
+        releaseFrontBlock_(start_block_ - 1);
+      }
+    }
+    if (size_ == 0) {
+      finish_block_ = start_block_;
+      finish_offset_ = start_offset_;
+    }
+  }
+// 作用：把逻辑区间 [first, last) 的元素按块连续片段移动到以 d_first 开头的位置（d_first <= first）。
+  void moveRange_(size_type first, size_type last, size_type d_first) {
+    assert(d_first <= first);
+    while (first < last) {
+      Location src = locate_(first);
+      Location dst = locate_(d_first);
+      size_type chunk = std::min({last - first, block_size - src.offset, block_size - dst.offset});
+      T* src_ptr = elementPtr_(src.block_index, src.offset);
+      T* dst_ptr = elementPtr_(dst.block_index, dst.offset);
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memmove(static_cast<void*>(dst_ptr), static_cast<const void*>(src_ptr), chunk * sizeof(T));
+      } else {
+        std::move(src_ptr, src_ptr + chunk, dst_ptr);
+      }
+      first += chunk;
+      d_first += chunk;
+    }
+  }
+// 作用：把逻辑区间 [first, last) 的元素按块连续片段从后往前移动到以 d_last 结尾的位置（d_last >= last）。
+  void moveRangeBackward_(size_type first, size_type last, size_type d_last) {
+    assert(d_last >= last);
+    while (first < last) {
+      Location src = locate_(last - 1);
+      Location dst = locate_(d_last - 1);
+      size_type chunk = std::min({last - first, src.offset + 1, dst.offset + 1});
+      T* src_end = elementPtr_(src.block_index, src.offset) + 1;
+      T* dst_end = elementPtr_(dst.block_index, dst.offset) + 1;
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memmove(static_cast<void*>(dst_end - chunk), static_cast<const void*>(src_end - chunk), chunk * sizeof(T));
+      } else {
+        std::move_backward(src_end - chunk, src_end, dst_end);
+      }
+      last -= chunk;
+      d_last -= chunk;
+    }
+  }
 // 作用：根据给定的索引定位元素在分段存储中的块索引和偏移量。
   Location locate_(size_type index) const {
     size_type absolute = start_offset_ + index;
-    size_type block_shift = absolute / block_size;
-    size_type offset = absolute % block_size;
-    size_type block_index = start_block_ + block_shift;
-    return {block_index, offset};
+    if constexpr (isPowerOfTwo(block_size)) {
+      constexpr size_type shift = log2OfPowerOfTwo(block_size);
+      return {start_block_ + (absolute >> shift), absolute & (block_size - 1)};
+    } else {
+      return {start_block_ + absolute / block_size, absolute % block_size};
+    }
   }
 // 作用：返回指向指定块索引和偏移量的元素的指针。
   T* elementPtr_(size_type block_index, size_type offset) const {
@@ -385,8 +1544,10 @@ class SegmentedStorage {
     if (start_offset_ == block_size) {
       start_offset_ = 0;
       ++start_block_;
+      // finish 所在块始终已分配，因此新的 start 块一定已经存在。
       assert(start_block_ < map_capacity_);
-      allocateBlockIfNeeded_(start_block_);
+      assert(map_[start_block_] != nullptr);
+      releaseFrontBlock_(start_block_ - 1);
     }
   }
 // 作用：将结束位置向后移动一个元素。
@@ -395,45 +1556,82 @@ class SegmentedStorage {
       assert(finish_block_ > 0);
       --finish_block_;
       finish_offset_ = block_size;
+      releaseBackBlock_(finish_block_ + 1);
     }
     --finish_offset_;
   }
-// 作用：在分段存储的末尾插入一个新元素。
-  template <class U>
-  void emplaceBack_(U&& value) {
-    growMapIfNeeded_(false);
-
+// 作用：将结束位置向后移动一个元素。
+  // 不变式：finish_offset_ < block_size，finish 所在块始终已分配，
+  // 这样 end() 迭代器总能指向一个真实的块。
+  void incrementFinish_() noexcept {
+    ++finish_offset_;
     if (finish_offset_ == block_size) {
       finish_offset_ = 0;
       ++finish_block_;
       assert(finish_block_ < map_capacity_);
-      allocateBlockIfNeeded_(finish_block_);
+      assert(map_[finish_block_] != nullptr);
+    }
+  }
+// 作用：在分段存储的末尾插入一个新元素。
+  template <class... Args>
+  T& emplaceBack_(Args&&... args) {
+    growMapIfNeeded_(false);
+
+    // 先分配下一个块再构造元素，构造失败或分配失败时容器保持不变。
+    // 下一个块可能是预留块，只有这次新挂上的块才在失败时归还。
+    bool allocated = false;
+    if (finish_offset_ + 1 == block_size) {
+      assert(finish_block_ + 1 < map_capacity_);
+      allocated = allocateBlockIfNeeded_(finish_block_ + 1);
+      ++stats_.blocks_pushed_back;
     }
 
     T* ptr = elementPtr_(finish_block_, finish_offset_);
-    constructAt(allocator_, ptr, std::forward<U>(value));
-    ++finish_offset_;
+    try {
+      constructAt(allocator_, ptr, std::forward<Args>(args)...);
+    } catch (...) {
+      if (allocated) {
+        releaseBlockAt_(finish_block_ + 1);
+      }
+      throw;
+    }
+    incrementFinish_();
     ++size_;
+    return *ptr;
   }
 // 作用：在分段存储的前端插入一个新元素。
-  template <class U>
-  void emplaceFront_(U&& value) {
+  template <class... Args>
+  T& emplaceFront_(Args&&... args) {
     growMapIfNeeded_(true);
 
-    if (start_offset_ == 0) {
-      assert(start_block_ > 0);
-      --start_block_;
-      allocateBlockIfNeeded_(start_block_);
-      start_offset_ = block_size;
+    size_type block_index = start_block_;
+    size_type offset = start_offset_;
+    bool allocated = false;
+    if (offset == 0) {
+      assert(block_index > 0);
+      --block_index;
+      allocated = allocateBlockIfNeeded_(block_index);
+      ++stats_.blocks_pushed_front;
+      offset = block_size;
     }
-    --start_offset_;
+    --offset;
 
-    T* ptr = elementPtr_(start_block_, start_offset_);
-    constructAt(allocator_, ptr, std::forward<U>(value));
+    T* ptr = elementPtr_(block_index, offset);
+    try {
+      constructAt(allocator_, ptr, std::forward<Args>(args)...);
+    } catch (...) {
+      if (allocated) {
+        releaseBlockAt_(block_index);
+      }
+      throw;
+    }
+    start_block_ = block_index;
+    start_offset_ = offset;
     ++size_;
+    return *ptr;
   }
 
-  map_allocator_type map_allocator_{};
+  map_allocator_type map_allocator_;
 };
 
 }  // namespace deque::detail
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace deque {
+
+// Allocator for very large deques: blocks are carved out of big mmap'd
+// regions advised with MADV_HUGEPAGE, so a scan touches few TLB entries and
+// no malloc metadata sits between blocks. Regions are slabs of one chunk size;
+// a region whose chunks are all returned is released (MADV_DONTNEED while a
+// few are retained for reuse, munmap beyond that). Requests too small for a
+// slab go to operator new, requests larger than a quarter region get their
+// own mapping. Without mmap (or when the kernel refuses the advice) it falls
+// back to ordinary pages transparently.
+//
+// All copies and rebinds share one arena; the arena is thread-safe.
+// Use it with a large block size, e.g. HugePageDeque<T> below.
+
+inline constexpr std::size_t huge_page_bytes = std::size_t{2} << 20;
+inline constexpr std::size_t default_huge_region_bytes = std::size_t{64} << 20;
+
+// 每块约一个大页（2 MiB），向下取整到 2 的幂。
+template <class T>
+constexpr std::size_t hugePageBlockSize() noexcept {
+  return detail::floorPowerOfTwo(huge_page_bytes / sizeof(T));
+}
+
+struct HugePageStats {
+  std::size_t regions_mapped = 0;      // 为分块区域调用 mmap 的次数
+  std::size_t regions_unmapped = 0;    // 腾空后 munmap 归还的区域数
+  std::size_t regions_retained = 0;    // 当前腾空但保留（已 MADV_DONTNEED）的区域数
+  std::size_t huge_page_advised = 0;   // madvise(MADV_HUGEPAGE) 成功的映射次数（区域 + 独立映射）
+  std::size_t dedicated_mappings = 0;  // 当前为大请求单独建立的映射数
+  std::size_t bytes_mapped = 0;        // 当前映射的虚拟地址空间字节数
+  std::size_t chunks_in_use = 0;       // 当前从区域中分出去的块数
+};
+
+namespace detail {
+
+class HugePageArena {
+ public:
+  // 小于该字节数的请求（小容器的映射数组等）直接交给 operator new，不占用大页区域。
+  static constexpr std::size_t small_request_bytes = 4096;
+  // 区域内的块按该粒度对齐。
+  static constexpr std::size_t chunk_alignment = 64;
+
+  // region_bytes 必须是大页大小的 2 的幂倍；retained_regions 为腾空后保留的区域数上限。
+  HugePageArena(std::size_t region_bytes, std::size_t retained_regions)
+      : region_bytes_(region_bytes), retained_limit_(retained_regions) {
+    assert(isPowerOfTwo(region_bytes_) && region_bytes_ >= huge_page_bytes);
+  }
+
+  HugePageArena(const HugePageArena&) = delete;
+  HugePageArena& operator=(const HugePageArena&) = delete;
+
+  ~HugePageArena() {
+    for (auto& entry : regions_) {
+      unmap_(entry.second.base, region_bytes_);
+    }
+    for (auto& entry : dedicated_) {
+      unmap_(reinterpret_cast<char*>(entry.first), entry.second);
+    }
+  }
+
+  std::size_t regionBytes() const noexcept { return region_bytes_; }
+
+  HugePageStats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    HugePageStats stats = stats_;
+    stats.regions_retained = retained_.size();
+    stats.dedicated_mappings = dedicated_.size();
+    return stats;
+  }
+
+  // 作用：按大小分派：小请求走 operator new，大请求单独映射，其余从同尺寸的区域中切块。
+  void* allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes < small_request_bytes) {
+      return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    assert(alignment <= chunk_alignment);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes > region_bytes_ / 4) {
+      return mapDedicated_(bytes);
+    }
+    return allocateChunk_(roundUp_(bytes, chunk_alignment));
+  }
+
+  // 作用：归还 allocate(bytes, alignment) 得到的内存；分派规则与 allocate 相同。
+  void deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept {
+    if (bytes < small_request_bytes) {
+      ::operator delete(ptr, std::align_val_t(alignment));
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes > region_bytes_ / 4) {
+      unmapDedicated_(ptr);
+      return;
+    }
+    deallocateChunk_(static_cast<char*>(ptr));
+  }
+
+ private:
+  // 一个区域只切一种尺寸的块：先用空闲链表，再从 bump 处继续切。
+  struct Region {
+    char* base = nullptr;
+    std::size_t chunk_bytes = 0;  // 0 表示腾空后保留、尚未分配给任何尺寸
+    std::size_t capacity = 0;     // 区域能容纳的块数
+    std::size_t bump = 0;         // 从未分出去过的第一个块
+    std::size_t live = 0;         // 已分出去的块数
+    char* free_head = nullptr;    // 归还的块组成的侵入式链表
+    bool available = false;       // 是否在 available_[chunk_bytes] 中
+  };
+
+  static std::size_t roundUp_(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  static bool full_(const Region& region) noexcept {
+    return region.free_head == nullptr && region.bump == region.capacity;
+  }
+
+  static char* takeChunk_(Region& region) noexcept {
+    char* chunk = region.free_head;
+    if (chunk != nullptr) {
+      std::memcpy(&region.free_head, chunk, sizeof(char*));
+    } else {
+      chunk = region.base + region.bump * region.chunk_bytes;
+      ++region.bump;
+    }
+    ++region.live;
+    return chunk;
+  }
+
+  // 作用：从可用区域中切一个块，没有可用区域时复用保留的空区域或映射新区域。
+  void* allocateChunk_(std::size_t chunk_bytes) {
+    std::vector<Region*>& candidates = available_[chunk_bytes];
+    Region* region = candidates.empty() ? nullptr : candidates.back();
+    if (region == nullptr) {
+      region = acquireRegion_(chunk_bytes);
+      region->available = true;
+      candidates.push_back(region);
+    }
+    char* chunk = takeChunk_(*region);
+    if (full_(*region)) {
+      region->available = false;
+      candidates.pop_back();
+    }
+    ++stats_.chunks_in_use;
+    return chunk;
+  }
+
+  // 作用：把块挂回所属区域的空闲链表；区域全部腾空时整体释放。
+  void deallocateChunk_(char* chunk) noexcept {
+    auto key = reinterpret_cast<std::uintptr_t>(chunk) & ~(static_cast<std::uintptr_t>(region_bytes_) - 1);
+    auto found = regions_.find(key);
+    assert(found != regions_.end());
+    Region& region = found->second;
+    std::memcpy(chunk, &region.free_head, sizeof(char*));
+    region.free_head = chunk;
+    --region.live;
+    --stats_.chunks_in_use;
+
+    std::vector<Region*>& candidates = available_.find(region.chunk_bytes)->second;
+    if (region.live == 0) {
+      if (region.available) {
+        candidates.erase(std::find(candidates.begin(), candidates.end(), &region));
+      }
+      releaseRegion_(found);
+      return;
+    }
+    if (!region.available) {
+      region.available = true;
+      candidates.push_back(&region);
+    }
+  }
+
+  Region* acquireRegion_(std::size_t chunk_bytes) {
+    Region* region = nullptr;
+    if (!retained_.empty()) {
+      region = retained_.back();
+      retained_.pop_back();
+    } else {
+      char* base = mapAligned_();
+      region = &regions_[reinterpret_cast<std::uintptr_t>(base)];
+      region->base = base;
+      ++stats_.regions_mapped;
+    }
+    region->chunk_bytes = chunk_bytes;
+    region->capacity = region_bytes_ / chunk_bytes;
+    region->bump = 0;
+    region->live = 0;
+    region->free_head = nullptr;
+    region->available = false;
+    return region;
+  }
+
+  // 作用：腾空的区域在保留上限内只归还物理页（MADV_DONTNEED），地址空间留着复用；超出上限时 munmap。
+  void releaseRegion_(std::unordered_map<std::uintptr_t, Region>::iterator found) noexcept {
+    Region& region = found->second;
+    if (retained_.size() < retained_limit_) {
+      discardPages_(region.base, region_bytes_);
+      region.chunk_bytes = 0;
+      region.available = false;
+      retained_.push_back(&region);
+      return;
+    }
+    unmap_(region.base, region_bytes_);
+    regions_.erase(found);
+    ++stats_.regions_unmapped;
+  }
+
+  // 作用：映射一个按 region_bytes_ 对齐的区域，块地址按掩码即可找到所属区域。
+  char* mapAligned_() {
+#if defined(__unix__) || defined(__APPLE__)
+    // 多映射一倍再裁掉对齐前后的部分。
+    char* raw = map_(region_bytes_ * 2);
+    auto address = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (address + region_bytes_ - 1) & ~(static_cast<std::uintptr_t>(region_bytes_) - 1);
+    char* base = reinterpret_cast<char*>(aligned);
+    if (base != raw) {
+      unmap_(raw, static_cast<std::size_t>(base - raw));
+    }
+    std::size_t tail = static_cast<std::size_t>(raw + region_bytes_ * 2 - (base + region_bytes_));
+    if (tail != 0) {
+      unmap_(base + region_bytes_, tail);
+    }
+#else
+    char* base = map_(region_bytes_);
+#endif
+    adviseHugePages_(base, region_bytes_);
+    return base;
+  }
+
+  void* mapDedicated_(std::size_t bytes) {
+    std::size_t length = roundUp_(bytes, huge_page_bytes);
+    char* base = map_(length);
+    adviseHugePages_(base, length);
+    dedicated_[reinterpret_cast<std::uintptr_t>(base)] = length;
+    return base;
+  }
+
+  void unmapDedicated_(void* ptr) noexcept {
+    auto found = dedicated_.find(reinterpret_cast<std::uintptr_t>(ptr));
+    assert(found != dedicated_.end());
+    unmap_(static_cast<char*>(ptr), found->second);
+    dedicated_.erase(found);
+  }
+
+  // 作用：映射 length 字节的匿名内存；没有 mmap 的平台退化为按区域大小对齐的 operator new。
+  char* map_(std::size_t length) {
+#if defined(__unix__) || defined(__APPLE__)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+#else
+    void* ptr = ::operator new(length, std::align_val_t(region_bytes_));
+#endif
+    stats_.bytes_mapped += length;
+    return static_cast<char*>(ptr);
+  }
+
+  void unmap_(char* base, std::size_t length) noexcept {
+    stats_.bytes_mapped -= length;
+#if defined(__unix__) || defined(__APPLE__)
+    ::munmap(base, length);
+#else
+    ::operator delete(base, std::align_val_t(region_bytes_));
+#endif
+  }
+
+  // 作用：请求透明大页；内核不支持或拒绝时保持普通页，不影响正确性。
+  void adviseHugePages_(char* base, std::size_t length) noexcept {
+#if defined(MADV_HUGEPAGE)
+    if (::madvise(base, length, MADV_HUGEPAGE) == 0) {
+      ++stats_.huge_page_advised;
+    }
+#else
+    (void)base;
+    (void)length;
+#endif
+  }
+
+  static void discardPages_(char* base, std::size_t length) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    ::madvise(base, length, MADV_DONTNEED);
+#else
+    (void)base;
+    (void)length;
+#endif
+  }
+
+  const std::size_t region_bytes_;
+  const std::size_t retained_limit_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::uintptr_t, Region> regions_;                  // 区域基址 -> 区域
+  std::unordered_map<std::size_t, std::vector<Region*>> available_;     // 块尺寸 -> 还有空闲块的区域
+  std::vector<Region*> retained_;                                       // 腾空后保留的区域
+  std::unordered_map<std::uintptr_t, std::size_t> dedicated_;           // 独立映射基址 -> 长度
+  HugePageStats stats_{};
+};
+
+}  // namespace detail
+
+template <class T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  // 所有副本共享同一个 arena，传播分配器总是安全的。
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  HugePageAllocator() : HugePageAllocator(default_huge_region_bytes) {}
+
+  explicit HugePageAllocator(std::size_t region_bytes, std::size_t retained_regions = 1)
+      : arena_(std::make_shared<detail::HugePageArena>(region_bytes, retained_regions)) {}
+
+  // 移动也是复制：移动后的分配器必须仍与原来的相等。
+  HugePageAllocator(const HugePageAllocator& other) noexcept = default;
+  HugePageAllocator& operator=(const HugePageAllocator& other) noexcept = default;
+
+  template <class U>
+  HugePageAllocator(const HugePageAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+  T* allocate(std::size_t count) {
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t count) noexcept { arena_->deallocate(ptr, count * sizeof(T), alignof(T)); }
+
+  HugePageStats stats() const { return arena_->stats(); }
+  std::size_t regionBytes() const noexcept { return arena_->regionBytes(); }
+
+  template <class U>
+  bool operator==(const HugePageAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+  template <class U>
+  bool operator!=(const HugePageAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  template <class>
+  friend class HugePageAllocator;
+
+  std::shared_ptr<detail::HugePageArena> arena_;
+};
+
+// 块大小约一个大页的 Deque。
+template <class T>
+using HugePageDeque = Deque<T, HugePageAllocator<T>, hugePageBlockSize<T>()>;
+
+}  // namespace deque
@@ -0,0 +1,543 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "deque/detail/index_iterator.hpp"
+#include "deque/detail/storage.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace deque {
+
+// Persistent deque of trivially copyable values kept in a memory-mapped file
+// (POSIX only). The layout follows SegmentedStorage — fixed-size blocks, a
+// map of block slots, start/finish cursors — but every link is a file offset
+// rather than a pointer, so the file can be closed and reopened in O(1): the
+// constructor validates a fixed header and nothing is rebuilt.
+//
+// The whole file lives inside one reserved address range, so growing the file
+// never moves existing elements: references stay valid until their element
+// is popped.
+//
+// Crash consistency: killing the process at any instant leaves the file in
+// the state after some prefix of the completed operations (at most the one
+// in flight is lost). Pushes and pops inside a block publish a single cursor
+// word after the element is written; operations that take or release a block,
+// or re-lay the map, write a complete new state into the inactive half of a
+// double-buffered header and then flip one index. Blocks handed back by pops
+// go to a file-resident stack and are reused by later pushes, map recentering
+// alternates between two equally sized map arrays, so steady-state FIFO
+// traffic does not grow the file. Only map and free-stack growth leave the
+// previous (geometrically smaller) arrays behind.
+//
+// Durability against power loss is the caller's choice via sync():
+// sync(SyncMode::blocking) returns once the file is on stable storage; writes
+// made after the last blocking sync may reach the disk in any order.
+//
+// Only one MappedDeque may have a given file open at a time (flock).
+
+enum class SyncMode {
+  blocking,  // msync(MS_SYNC)：返回时数据已落盘
+  async,     // msync(MS_ASYNC)：只安排回写
+};
+
+namespace detail {
+
+// 一次提交的完整状态；"指针"都是相对文件开头的字节偏移。
+struct MappedState {
+  std::uint64_t map_offset[2];  // 两份等长的映射数组，原地重新居中时在二者之间切换
+  std::uint64_t map_index;      // 当前使用的映射数组
+  std::uint64_t map_capacity;   // 映射数组的槽数
+  std::uint64_t start;          // 段空间中的绝对位置：块号 = pos / BlockSize，块内偏移 = pos % BlockSize
+  std::uint64_t finish;
+  std::uint64_t free_offset;    // 空闲块栈：保存块偏移的数组
+  std::uint64_t free_capacity;
+  std::uint64_t free_count;
+  std::uint64_t used_bytes;     // 文件中已分配出去的字节数（bump 位置）
+};
+
+struct MappedHeader {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t element_size;
+  std::uint64_t block_size;
+  std::uint32_t active;  // 当前生效的状态槽
+  std::uint32_t padding;
+  MappedState states[2];
+};
+
+inline constexpr std::uint64_t mapped_magic = 0x3130'5041'4d51'4544ULL;  // "DEQMAP01"
+inline constexpr std::uint32_t mapped_version = 1;
+// 文件头独占的字节数，之后才是映射数组、空闲栈与数据块。
+inline constexpr std::size_t mapped_header_bytes = 4096;
+// 文件按该粒度增长（也是扩展映射的对齐单位，覆盖常见页大小）。
+inline constexpr std::size_t mapped_file_granule = std::size_t{1} << 20;
+// 单次增长的上限，避免大文件按倍数增长时一次占用过多磁盘。
+inline constexpr std::size_t mapped_max_growth_bytes = std::size_t{1} << 30;
+inline constexpr std::size_t mapped_alignment = 64;
+
+static_assert(sizeof(MappedHeader) <= mapped_header_bytes, "MappedHeader must fit in its page");
+
+[[noreturn]] inline void throwMappedError(const char* what) {
+  throw std::system_error(errno, std::generic_category(), std::string("MappedDeque: ") + what);
+}
+
+}  // namespace detail
+
+template <class T, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class MappedDeque {
+  static_assert(std::is_trivially_copyable_v<T>, "MappedDeque stores raw bytes and needs trivially copyable T");
+  static_assert(BlockSize > 0, "BlockSize must be positive");
+  static_assert(alignof(T) <= detail::mapped_alignment, "MappedDeque blocks are 64-byte aligned");
+  static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "MappedDeque needs a 64-bit address space");
+
+ public:
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::IndexIterator<MappedDeque, false>;
+  using const_iterator = detail::IndexIterator<MappedDeque, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type block_size = BlockSize;
+  static constexpr size_type block_bytes = BlockSize * sizeof(T);
+  // 预留的虚拟地址空间（不占内存），也是文件大小的上限。
+  static constexpr size_type default_reserve_bytes = size_type{1} << 36;
+  static constexpr size_type initial_map_capacity = 8;
+  static constexpr size_type initial_free_capacity = 16;
+
+  // Opens path, creating an empty deque if the file is missing or empty.
+  // Throws std::system_error on I/O failure and std::runtime_error when the
+  // file holds a different element size or block size.
+  explicit MappedDeque(const std::string& path, size_type reserve_bytes = default_reserve_bytes) : path_(path) {
+    try {
+      open_(reserve_bytes);
+    } catch (...) {
+      close_();
+      throw;
+    }
+  }
+
+  MappedDeque(const MappedDeque&) = delete;
+  MappedDeque& operator=(const MappedDeque&) = delete;
+
+  // A moved-from MappedDeque owns no file and reads as empty: size(), empty(),
+  // iteration, path() and clear() are valid; pushes, pops and element access
+  // are not. Destroy it or move-assign a live deque into it.
+  MappedDeque(MappedDeque&& other) noexcept
+      : path_(std::move(other.path_)), fd_(std::exchange(other.fd_, -1)), base_(std::exchange(other.base_, nullptr)),
+        reserve_bytes_(std::exchange(other.reserve_bytes_, 0)), mapped_bytes_(std::exchange(other.mapped_bytes_, 0)) {}
+
+  MappedDeque& operator=(MappedDeque&& other) noexcept {
+    if (this != &other) {
+      MappedDeque moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  // 析构不强制落盘：写入已在页缓存中，进程退出后仍会写回文件。
+  ~MappedDeque() { close_(); }
+
+  void swap(MappedDeque& other) noexcept {
+    using std::swap;
+    swap(path_, other.path_);
+    swap(fd_, other.fd_);
+    swap(base_, other.base_);
+    swap(reserve_bytes_, other.reserve_bytes_);
+    swap(mapped_bytes_, other.mapped_bytes_);
+  }
+
+  const std::string& path() const noexcept { return path_; }
+  // 作用：当前文件长度（字节）。
+  size_type fileBytes() const noexcept { return mapped_bytes_; }
+
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept {
+    if (base_ == nullptr) {
+      return 0;
+    }
+    const detail::MappedState& state = state_();
+    return state.finish - state.start;
+  }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size()); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cend() const noexcept { return const_iterator(this, size()); }
+
+  reverse_iterator rBegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rBegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rEnd() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rEnd() const noexcept { return const_reverse_iterator(begin()); }
+
+  reference operator[](size_type index) {
+    const detail::MappedState& state = state_();
+    return *slot_(state, state.start + index);
+  }
+  const_reference operator[](size_type index) const {
+    const detail::MappedState& state = state_();
+    return *slot_(state, state.start + index);
+  }
+
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size() - 1]; }
+  const_reference back() const { return (*this)[size() - 1]; }
+
+  // 作用：尾部追加。块内只写元素再发布 finish；进入新块时整份状态一次提交。
+  void pushBack(const value_type& value) {
+    // 元素地址在文件增长时不变，value 引用自身元素也安全。
+    if (state_().finish == state_().map_capacity * BlockSize) {
+      relayoutMap_();
+    }
+    detail::MappedState& state = state_();
+    const std::uint64_t pos = state.finish;
+    if (state.start == state.finish || pos % BlockSize == 0) {
+      detail::MappedState next = state;
+      std::uint64_t block = takeBlock_(next);
+      map_(next)[pos / BlockSize] = block;
+      std::memcpy(blockData_(block) + pos % BlockSize, &value, sizeof(T));
+      next.finish = pos + 1;
+      commit_(next);
+      return;
+    }
+    std::memcpy(slot_(state, pos), &value, sizeof(T));
+    publish_(state.finish, pos + 1);
+  }
+
+  // 作用：头部插入，与 pushBack 对称。
+  void pushFront(const value_type& value) {
+    if (state_().start == 0) {
+      relayoutMap_();
+    }
+    detail::MappedState& state = state_();
+    const std::uint64_t pos = state.start - 1;
+    if (state.start == state.finish || state.start % BlockSize == 0) {
+      detail::MappedState next = state;
+      std::uint64_t block = takeBlock_(next);
+      map_(next)[pos / BlockSize] = block;
+      std::memcpy(blockData_(block) + pos % BlockSize, &value, sizeof(T));
+      next.start = pos;
+      commit_(next);
+      return;
+    }
+    std::memcpy(slot_(state, pos), &value, sizeof(T));
+    publish_(state.start, pos);
+  }
+
+  // 作用：尾部删除；块被取空时把块压回空闲栈并一次提交。
+  void popBack() {
+    assert(!empty());
+    detail::MappedState& state = state_();
+    const std::uint64_t pos = state.finish - 1;
+    if (state.finish - state.start == 1 || pos % BlockSize == 0) {
+      detail::MappedState next = state;
+      releaseBlock_(next, map_(state)[pos / BlockSize]);
+      next.finish = pos;
+      commit_(next);
+      return;
+    }
+    publish_(state.finish, pos);
+  }
+
+  void popFront() {
+    assert(!empty());
+    detail::MappedState& state = state_();
+    const std::uint64_t pos = state.start;
+    if (state.finish - state.start == 1 || (pos + 1) % BlockSize == 0) {
+      detail::MappedState next = state;
+      releaseBlock_(next, map_(state)[pos / BlockSize]);
+      next.start = pos + 1;
+      commit_(next);
+      return;
+    }
+    publish_(state.start, pos + 1);
+  }
+
+  // 作用：清空并把全部块归还空闲栈（文件不缩小），游标回到映射中央。
+  void clear() {
+    if (size() == 0) {
+      return;
+    }
+    const detail::MappedState& state = state_();
+    detail::MappedState next = state;
+    const std::uint64_t first = state.start / BlockSize;
+    const std::uint64_t last = (state.finish - 1) / BlockSize;
+    reserveFreeSlots_(next, last - first + 1);
+    const std::uint64_t* map = map_(state);
+    std::uint64_t* free_blocks = freeStack_(next);
+    for (std::uint64_t block = first; block <= last; ++block) {
+      free_blocks[next.free_count++] = map[block];
+    }
+    next.start = next.finish = next.map_capacity / 2 * BlockSize;
+    commit_(next);
+  }
+
+  // Flushes the mapping to the file. SyncMode::blocking returns once the data
+  // is on stable storage; SyncMode::async only schedules the write-back.
+  void sync(SyncMode mode = SyncMode::blocking) {
+    if (::msync(base_, mapped_bytes_, mode == SyncMode::blocking ? MS_SYNC : MS_ASYNC) != 0) {
+      detail::throwMappedError("msync");
+    }
+  }
+
+ private:
+  detail::MappedHeader* header_() const noexcept { return reinterpret_cast<detail::MappedHeader*>(base_); }
+
+  detail::MappedState& state_() const noexcept {
+    detail::MappedHeader* header = header_();
+    return header->states[header->active];
+  }
+
+  std::uint64_t* map_(const detail::MappedState& state) const noexcept {
+    return reinterpret_cast<std::uint64_t*>(base_ + state.map_offset[state.map_index]);
+  }
+
+  std::uint64_t* freeStack_(const detail::MappedState& state) const noexcept {
+    return reinterpret_cast<std::uint64_t*>(base_ + state.free_offset);
+  }
+
+  T* blockData_(std::uint64_t block) const noexcept { return reinterpret_cast<T*>(base_ + block); }
+
+  T* slot_(const detail::MappedState& state, std::uint64_t pos) const noexcept {
+    return blockData_(map_(state)[pos / BlockSize]) + pos % BlockSize;
+  }
+
+  // 作用：发布单个游标。之前写入的元素必须先于游标落到映射内存（编译器屏障即可：
+  // 进程被杀时已执行的存储都留在页缓存里）。
+  static void publish_(std::uint64_t& cursor, std::uint64_t value) noexcept {
+    std::atomic_signal_fence(std::memory_order_release);
+    cursor = value;
+  }
+
+  // 作用：把完整的新状态写进非活动槽，再翻转 active。翻转前的任何时刻崩溃都只看到旧状态。
+  void commit_(const detail::MappedState& next) noexcept {
+    detail::MappedHeader* header = header_();
+    const std::uint32_t inactive = 1 - header->active;
+    header->states[inactive] = next;
+    std::atomic_signal_fence(std::memory_order_release);
+    header->active = inactive;
+  }
+
+  // 作用：取一个空闲块：先用空闲栈，再从文件末尾切。只修改 next，提交前旧状态不受影响。
+  std::uint64_t takeBlock_(detail::MappedState& next) {
+    if (next.free_count > 0) {
+      return freeStack_(next)[--next.free_count];
+    }
+    return allocateBytes_(next, block_bytes);
+  }
+
+  // 作用：把块压入空闲栈；写入的栈槽在旧状态中位于栈顶之外，不影响旧状态。
+  void releaseBlock_(detail::MappedState& next, std::uint64_t block) {
+    reserveFreeSlots_(next, 1);
+    freeStack_(next)[next.free_count++] = block;
+  }
+
+  // 作用：保证空闲栈还能再压入 extra 个块；不够时换一个更大的数组（旧数组留在文件中）。
+  void reserveFreeSlots_(detail::MappedState& next, std::uint64_t extra) {
+    if (next.free_count + extra <= next.free_capacity) {
+      return;
+    }
+    std::uint64_t capacity = std::max<std::uint64_t>(initial_free_capacity, next.free_capacity * 2);
+    capacity = std::max(capacity, next.free_count + extra);
+    std::uint64_t offset = allocateBytes_(next, capacity * sizeof(std::uint64_t));
+    if (next.free_count != 0) {
+      std::memcpy(base_ + offset, freeStack_(next), next.free_count * sizeof(std::uint64_t));
+    }
+    next.free_offset = offset;
+    next.free_capacity = capacity;
+  }
+
+  // 作用：游标到达映射一端时重新布局：空间充裕就居中复制到另一份映射数组，否则换一对两倍大的数组。
+  void relayoutMap_() {
+    detail::MappedState next = state_();
+    const std::uint64_t size = next.finish - next.start;
+    const std::uint64_t first_block = next.start / BlockSize;
+    const std::uint64_t used_blocks = size == 0 ? 0 : (next.finish - 1) / BlockSize - first_block + 1;
+    const std::uint64_t* old_map = map_(next);
+
+    std::uint64_t capacity = next.map_capacity;
+    if (2 * (used_blocks + 1) <= capacity) {
+      next.map_index = 1 - next.map_index;
+    } else {
+      capacity *= 2;
+      next.map_offset[0] = allocateBytes_(next, capacity * sizeof(std::uint64_t));
+      next.map_offset[1] = allocateBytes_(next, capacity * sizeof(std::uint64_t));
+      next.map_index = 0;
+      next.map_capacity = capacity;
+    }
+    const std::uint64_t new_first = (capacity - used_blocks) / 2;
+    if (used_blocks != 0) {
+      std::memcpy(map_(next) + new_first, old_map + first_block, used_blocks * sizeof(std::uint64_t));
+    }
+    next.start = new_first * BlockSize + next.start % BlockSize;
+    next.finish = next.start + size;
+    commit_(next);
+  }
+
+  // 作用：在文件中切出 bytes 字节（64 字节对齐），必要时扩展文件与映射。
+  std::uint64_t allocateBytes_(detail::MappedState& next, std::uint64_t bytes) {
+    const std::uint64_t offset = roundUp_(next.used_bytes, detail::mapped_alignment);
+    ensureFileBytes_(offset + bytes);
+    next.used_bytes = offset + bytes;
+    return offset;
+  }
+
+  // 作用：文件不足 bytes 时扩展文件，并把新增部分映射到预留区间紧接的位置（已有地址不变）。
+  void ensureFileBytes_(std::uint64_t bytes) {
+    if (bytes <= mapped_bytes_) {
+      return;
+    }
+    size_type target = roundUp_(bytes, detail::mapped_file_granule);
+    target = std::max(target, mapped_bytes_ + std::min(mapped_bytes_, detail::mapped_max_growth_bytes));
+    target = std::min(target, reserve_bytes_);
+    if (target < bytes) {
+      throw std::length_error("MappedDeque: file would exceed the reserved address range");
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(target)) != 0) {
+      detail::throwMappedError("ftruncate");
+    }
+    mapFile_(mapped_bytes_, target);
+  }
+
+  void mapFile_(size_type from, size_type to) {
+    void* ptr = ::mmap(base_ + from, to - from, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_,
+                       static_cast<off_t>(from));
+    if (ptr == MAP_FAILED) {
+      detail::throwMappedError("mmap");
+    }
+    mapped_bytes_ = to;
+  }
+
+  void open_(size_type reserve_bytes) {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      detail::throwMappedError("open");
+    }
+    if (::flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+      detail::throwMappedError("flock");
+    }
+    struct stat info {};
+    if (::fstat(fd_, &info) != 0) {
+      detail::throwMappedError("fstat");
+    }
+    const auto file_bytes = static_cast<size_type>(info.st_size);
+    if (file_bytes % detail::mapped_file_granule != 0) {
+      throw std::runtime_error("MappedDeque: file length is not a multiple of the growth granule");
+    }
+
+    // 先占下一整段不可访问的地址空间，文件始终映射在它的开头。
+    reserve_bytes_ = std::max(roundUp_(reserve_bytes, detail::mapped_file_granule), file_bytes);
+    reserve_bytes_ = std::max(reserve_bytes_, detail::mapped_file_granule);
+    void* base = ::mmap(nullptr, reserve_bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+      detail::throwMappedError("mmap reserve");
+    }
+    base_ = static_cast<char*>(base);
+
+    if (file_bytes != 0) {
+      mapFile_(0, file_bytes);
+      // magic 最后写入：为 0 说明创建过程中崩溃，按新文件重新初始化。
+      if (header_()->magic != 0) {
+        validateHeader_();
+        return;
+      }
+    }
+    initialize_();
+  }
+
+  void validateHeader_() const {
+    const detail::MappedHeader* header = header_();
+    if (header->magic != detail::mapped_magic || header->version != detail::mapped_version || header->active > 1) {
+      throw std::runtime_error("MappedDeque: not a MappedDeque file");
+    }
+    if (header->element_size != sizeof(T) || header->block_size != BlockSize) {
+      throw std::runtime_error("MappedDeque: file was written with a different element or block size");
+    }
+    // 只检查固定数量的字段，打开仍是 O(1)。
+    const detail::MappedState& state = header->states[header->active];
+    const std::uint64_t map_bytes = state.map_capacity * sizeof(std::uint64_t);
+    const bool consistent = state.used_bytes <= mapped_bytes_ && state.map_index <= 1 &&
+                            state.map_offset[0] + map_bytes <= state.used_bytes &&
+                            state.map_offset[1] + map_bytes <= state.used_bytes &&
+                            state.free_offset + state.free_capacity * sizeof(std::uint64_t) <= state.used_bytes &&
+                            state.free_count <= state.free_capacity && state.start <= state.finish &&
+                            state.finish <= state.map_capacity * BlockSize;
+    if (!consistent) {
+      throw std::runtime_error("MappedDeque: corrupt header");
+    }
+  }
+
+  // 作用：在空文件上建立文件头、两份映射数组与空状态。
+  void initialize_() {
+    ensureFileBytes_(detail::mapped_header_bytes);
+    detail::MappedState state{};
+    state.used_bytes = detail::mapped_header_bytes;
+    state.map_capacity = initial_map_capacity;
+    state.map_offset[0] = allocateBytes_(state, initial_map_capacity * sizeof(std::uint64_t));
+    state.map_offset[1] = allocateBytes_(state, initial_map_capacity * sizeof(std::uint64_t));
+    state.start = state.finish = initial_map_capacity / 2 * BlockSize;
+
+    detail::MappedHeader* header = header_();
+    header->version = detail::mapped_version;
+    header->element_size = sizeof(T);
+    header->block_size = BlockSize;
+    header->active = 0;
+    header->states[0] = state;
+    std::atomic_signal_fence(std::memory_order_release);
+    header->magic = detail::mapped_magic;
+  }
+
+  void close_() noexcept {
+    if (base_ != nullptr) {
+      ::munmap(base_, reserve_bytes_);
+      base_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    reserve_bytes_ = 0;
+    mapped_bytes_ = 0;
+  }
+
+  static std::uint64_t roundUp_(std::uint64_t value, std::uint64_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  std::string path_;
+  int fd_ = -1;
+  char* base_ = nullptr;
+  size_type reserve_bytes_ = 0;  // 预留的地址空间
+  size_type mapped_bytes_ = 0;   // 文件长度，也是已映射的前缀长度
+};
+
+template <class T, std::size_t BlockSize>
+inline void swap(MappedDeque<T, BlockSize>& lhs, MappedDeque<T, BlockSize>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace deque
@@ -0,0 +1,505 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "deque/algorithm.hpp"
+#include "deque/detail/iterator.hpp"
+#include "deque/detail/segment.hpp"
+
+namespace deque {
+
+namespace detail {
+
+// Splits [first, last) into at most max_parts contiguous parts whose
+// interior boundaries fall on block boundaries, so no two parts share a
+// block (or a cache line of one). Only the first and last part may start or
+// end inside a block, because the range itself does.
+template <class Storage, bool is_const>
+class BlockPartition {
+ public:
+  using iterator = DequeIterator<Storage, is_const>;
+
+  BlockPartition(DequeIterator<Storage, is_const> first, DequeIterator<Storage, is_const> last, std::size_t max_parts)
+      : size_(static_cast<std::size_t>(last - first)) {
+    if (size_ == 0 || max_parts == 0) {
+      return;
+    }
+    head_ = (*SegmentIterator<Storage, is_const>(first, last)).size();
+    blocks_ = 1 + (size_ - head_ + Storage::block_size - 1) / Storage::block_size;
+    parts_ = std::min(max_parts, blocks_);
+  }
+
+  std::size_t parts() const noexcept { return parts_; }
+
+  // 作用：第 part 段的起点（相对 first 的元素偏移）；offset(parts()) == 区间长度。
+  std::size_t offset(std::size_t part) const noexcept {
+    std::size_t block = blocks_ * part / parts_;
+    return block == 0 ? 0 : std::min(size_, head_ + (block - 1) * Storage::block_size);
+  }
+
+ private:
+  std::size_t size_ = 0;
+  std::size_t head_ = 0;    // 首块中落在区间内的元素数
+  std::size_t blocks_ = 0;  // 区间触及的块数
+  std::size_t parts_ = 0;
+};
+
+}  // namespace detail
+
+// Parallel algorithms over Deque iterator ranges.
+// Work is split along whole blocks of the map (detail::BlockPartition) and
+// every part runs the segmented algorithm from algorithm.hpp, so workers never
+// share a block and the inner loops stay on raw pointers.
+//
+// Each algorithm takes an optional executor as its first argument; without
+// one it uses defaultPool(). An executor provides
+//   std::size_t concurrency() const;
+//   void run(std::size_t count, const std::function<void(std::size_t)>& task);
+// where run() calls task(0) .. task(count - 1), possibly concurrently, returns
+// once all have finished and rethrows the first exception a task threw.
+// ThreadPool and InlineExecutor below are the two stock executors.
+namespace parallel {
+
+// 区间短于该长度时不拆分，直接在调用线程上执行。
+inline constexpr std::size_t min_parallel_elements = std::size_t{1} << 14;
+// 遍历类算法每个工作线程分到的段数；多切几段让先做完的线程接着领。
+inline constexpr std::size_t parts_per_worker = 4;
+
+// Runs every task on the calling thread.
+class InlineExecutor {
+ public:
+  std::size_t concurrency() const noexcept { return 1; }
+
+  void run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    for (std::size_t index = 0; index < count; ++index) {
+      task(index);
+    }
+  }
+};
+
+// Fixed-size pool: concurrency() - 1 worker threads plus the caller, which
+// takes tasks too. Tasks are handed out through one atomic counter. run()
+// calls are serialised; a run() issued from inside a task of the same pool
+// executes inline instead of deadlocking.
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t concurrency = std::max(1u, std::thread::hardware_concurrency())) {
+    for (std::size_t i = 1; i < concurrency; ++i) {
+      workers_.emplace_back([this] { workerLoop_(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::size_t concurrency() const noexcept { return workers_.size() + 1; }
+
+  void run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count <= 1 || workers_.empty() || current_pool_ == this) {
+      for (std::size_t index = 0; index < count; ++index) {
+        task(index);
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> serial(run_mutex_);
+    auto job = std::make_shared<Job>(task, count);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = job;
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    current_pool_ = this;
+    work_(*job);
+    current_pool_ = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [&] { return job->finished.load(std::memory_order_acquire) == count; });
+      job_.reset();
+    }
+    if (job->error) {
+      std::rethrow_exception(job->error);
+    }
+  }
+
+ private:
+  // 一次 run() 的状态；工作线程持有 shared_ptr，晚到的线程只会看到任务已领完。
+  struct Job {
+    Job(const std::function<void(std::size_t)>& task, std::size_t count) : task(task), count(count) {}
+
+    const std::function<void(std::size_t)>& task;  // 只在 run() 返回前、下标小于 count 时调用
+    const std::size_t count;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> finished{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  // 作用：领取并执行任务直到领完；出错后其余任务只计数不执行。
+  void work_(Job& job) {
+    for (;;) {
+      std::size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= job.count) {
+        return;
+      }
+      if (!job.failed.load(std::memory_order_relaxed)) {
+        try {
+          job.task(index);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(job.error_mutex);
+          if (!job.error) {
+            job.error = std::current_exception();
+          }
+          job.failed.store(true, std::memory_order_relaxed);
+        }
+      }
+      if (job.finished.fetch_add(1, std::memory_order_acq_rel) + 1 == job.count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+      }
+    }
+  }
+
+  void workerLoop_() {
+    current_pool_ = this;
+    std::size_t seen = 0;
+    for (;;) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+        if (stopping_) {
+          return;
+        }
+        seen = generation_;
+        job = job_;
+      }
+      if (job) {
+        work_(*job);
+      }
+    }
+  }
+
+  inline static thread_local ThreadPool* current_pool_ = nullptr;
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;  // 串行化 run()
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::shared_ptr<Job> job_;
+  std::size_t generation_ = 0;
+  bool stopping_ = false;
+};
+
+// 作用：进程级的默认线程池，按硬件线程数创建，首次使用时启动。
+inline ThreadPool& defaultPool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+namespace detail {
+
+using deque::detail::BlockPartition;
+using deque::detail::DequeIterator;
+
+// 作用：按块边界切分 [first, last)，对每段调用 fn(段起点, 段终点, 段相对 first 的偏移)。
+template <class Executor, class Storage, bool is_const, class PartFunction>
+void forEachPart(Executor& executor, DequeIterator<Storage, is_const> first, DequeIterator<Storage, is_const> last,
+                 std::size_t max_parts, PartFunction&& fn) {
+  const auto size = static_cast<std::size_t>(last - first);
+  BlockPartition<Storage, is_const> partition(first, last, size < min_parallel_elements ? 1 : max_parts);
+  executor.run(partition.parts(), [&](std::size_t part) {
+    const std::size_t begin = partition.offset(part);
+    fn(first + static_cast<std::ptrdiff_t>(begin),
+       first + static_cast<std::ptrdiff_t>(partition.offset(part + 1)), begin);
+  });
+}
+
+// 作用：一轮归并：相邻两段有序序列从 src 归并到 dst（落单的末段直接搬过去）。
+// 每对按 A 段等分成若干片，用 lower_bound 在 B 段中找对应的切点，各片可并行且保持稳定。
+template <class Executor, class Source, class Dest, class Compare>
+void mergeRound(Executor& executor, Source src, Dest dst, const std::vector<std::size_t>& bounds,
+                std::vector<std::size_t>& merged_bounds, Compare& comp) {
+  struct Piece {
+    std::size_t a_begin, a_end, b_begin, b_end, out;
+  };
+  auto at = [](auto base, std::size_t offset) { return base + static_cast<std::ptrdiff_t>(offset); };
+
+  const std::size_t runs = bounds.size() - 1;
+  const std::size_t pairs = runs / 2;
+  const std::size_t pieces_per_pair =
+      std::max<std::size_t>(1, executor.concurrency() * parts_per_worker / std::max<std::size_t>(pairs, 1));
+
+  std::vector<Piece> pieces;
+  merged_bounds.clear();
+  for (std::size_t pair = 0; pair < pairs; ++pair) {
+    const std::size_t lo = bounds[2 * pair];
+    const std::size_t mid = bounds[2 * pair + 1];
+    const std::size_t hi = bounds[2 * pair + 2];
+    merged_bounds.push_back(lo);
+    std::size_t b_begin = mid;
+    for (std::size_t piece = 0; piece < pieces_per_pair; ++piece) {
+      const std::size_t a_begin = lo + (mid - lo) * piece / pieces_per_pair;
+      const std::size_t a_end = lo + (mid - lo) * (piece + 1) / pieces_per_pair;
+      std::size_t b_end = hi;
+      if (piece + 1 < pieces_per_pair) {
+        b_end = static_cast<std::size_t>(std::lower_bound(at(src, b_begin), at(src, hi), *at(src, a_end), comp) - src);
+      }
+      if (a_begin != a_end || b_begin != b_end) {
+        pieces.push_back({a_begin, a_end, b_begin, b_end, a_begin + (b_begin - mid)});
+      }
+      b_begin = b_end;
+    }
+  }
+  if (runs % 2 != 0) {
+    const std::size_t lo = bounds[runs - 1];
+    const std::size_t hi = bounds[runs];
+    merged_bounds.push_back(lo);
+    pieces.push_back({lo, hi, hi, hi, lo});
+  }
+  merged_bounds.push_back(bounds[runs]);
+
+  executor.run(pieces.size(), [&](std::size_t index) {
+    const Piece& piece = pieces[index];
+    std::merge(std::make_move_iterator(at(src, piece.a_begin)), std::make_move_iterator(at(src, piece.a_end)),
+               std::make_move_iterator(at(src, piece.b_begin)), std::make_move_iterator(at(src, piece.b_end)),
+               at(dst, piece.out), comp);
+  });
+}
+
+// 作用：并行排序的骨架：各段搬进缓冲区分别排序，再在缓冲区与原区间之间逐轮归并。
+template <class Executor, class Storage, class Compare, class SortRun>
+void sortByRuns(Executor& executor, DequeIterator<Storage, false> first, DequeIterator<Storage, false> last,
+                Compare& comp, SortRun sort_run) {
+  using value_type = typename Storage::value_type;
+  const auto size = static_cast<std::size_t>(last - first);
+  BlockPartition<Storage, false> partition(first, last,
+                                           size < min_parallel_elements ? 1 : executor.concurrency());
+  if (partition.parts() <= 1) {
+    sort_run(first, last);
+    return;
+  }
+
+  std::vector<std::size_t> bounds(partition.parts() + 1);
+  for (std::size_t part = 0; part <= partition.parts(); ++part) {
+    bounds[part] = partition.offset(part);
+  }
+  // 默认初始化：平凡类型不做清零
+  std::unique_ptr<value_type[]> buffer(new value_type[size]);
+  value_type* scratch = buffer.get();
+
+  executor.run(partition.parts(), [&](std::size_t part) {
+    auto begin = first + static_cast<std::ptrdiff_t>(bounds[part]);
+    auto end = first + static_cast<std::ptrdiff_t>(bounds[part + 1]);
+    value_type* out = scratch + bounds[part];
+    for (auto segment : deque::segmentsOf(begin, end)) {
+      out = std::move(segment.begin(), segment.end(), out);
+    }
+    sort_run(scratch + bounds[part], out);
+  });
+
+  // 有序段在 scratch 中；每轮归并后交换方向，最后确保结果回到原区间。
+  std::vector<std::size_t> merged;
+  bool in_scratch = true;
+  while (bounds.size() > 2) {
+    if (in_scratch) {
+      mergeRound(executor, scratch, first, bounds, merged, comp);
+    } else {
+      mergeRound(executor, first, scratch, bounds, merged, comp);
+    }
+    bounds.swap(merged);
+    in_scratch = !in_scratch;
+  }
+  if (in_scratch) {
+    forEachPart(executor, first, last, parts_per_worker * executor.concurrency(),
+                [&](auto begin, auto end, std::size_t offset) {
+                  const value_type* in = scratch + offset;
+                  for (auto segment : deque::segmentsOf(begin, end)) {
+                    std::move(in, in + segment.size(), segment.begin());
+                    in += segment.size();
+                  }
+                });
+  }
+}
+
+}  // namespace detail
+
+// Calls fn on every element; each part works on its own copy of fn.
+template <class Executor, class Storage, bool is_const, class UnaryFunction>
+void forEach(Executor& executor, detail::DequeIterator<Storage, is_const> first,
+             detail::DequeIterator<Storage, is_const> last, UnaryFunction fn) {
+  detail::forEachPart(executor, first, last, parts_per_worker * executor.concurrency(),
+                      [&](auto begin, auto end, std::size_t) { deque::forEach(begin, end, fn); });
+}
+
+template <class Storage, bool is_const, class UnaryFunction>
+void forEach(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last,
+             UnaryFunction fn) {
+  parallel::forEach(defaultPool(), first, last, std::move(fn));
+}
+
+// dest must be a random access iterator; [dest, dest + (last - first)) must
+// not overlap the input unless it is the input itself.
+template <class Executor, class Storage, bool is_const, class RandomIt, class UnaryOperation>
+RandomIt transform(Executor& executor, detail::DequeIterator<Storage, is_const> first,
+                   detail::DequeIterator<Storage, is_const> last, RandomIt dest, UnaryOperation op) {
+  detail::forEachPart(executor, first, last, parts_per_worker * executor.concurrency(),
+                      [&](auto begin, auto end, std::size_t offset) {
+                        RandomIt out = dest + static_cast<std::ptrdiff_t>(offset);
+                        for (auto segment : deque::segmentsOf(begin, end)) {
+                          out = std::transform(segment.begin(), segment.end(), out, op);
+                        }
+                      });
+  return dest + (last - first);
+}
+
+template <class Storage, bool is_const, class RandomIt, class UnaryOperation>
+RandomIt transform(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last,
+                   RandomIt dest, UnaryOperation op) {
+  return parallel::transform(defaultPool(), first, last, dest, std::move(op));
+}
+
+template <class Executor, class Storage, bool is_const, class RandomIt>
+RandomIt copy(Executor& executor, detail::DequeIterator<Storage, is_const> first,
+              detail::DequeIterator<Storage, is_const> last, RandomIt dest) {
+  detail::forEachPart(executor, first, last, parts_per_worker * executor.concurrency(),
+                      [&](auto begin, auto end, std::size_t offset) {
+                        deque::copy(begin, end, dest + static_cast<std::ptrdiff_t>(offset));
+                      });
+  return dest + (last - first);
+}
+
+template <class Storage, bool is_const, class RandomIt>
+RandomIt copy(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last,
+              RandomIt dest) {
+  return parallel::copy(defaultPool(), first, last, dest);
+}
+
+template <class Executor, class Storage, class T>
+void fill(Executor& executor, detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last,
+          const T& value) {
+  detail::forEachPart(executor, first, last, parts_per_worker * executor.concurrency(),
+                      [&](auto begin, auto end, std::size_t) { deque::fill(begin, end, value); });
+}
+
+template <class Storage, class T>
+void fill(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last, const T& value) {
+  parallel::fill(defaultPool(), first, last, value);
+}
+
+// op must be associative; parts are combined left to right, so it need not
+// be commutative.
+template <class Executor, class Storage, bool is_const, class T, class BinaryOperation>
+T reduce(Executor& executor, detail::DequeIterator<Storage, is_const> first,
+         detail::DequeIterator<Storage, is_const> last, T init, BinaryOperation op) {
+  const auto size = static_cast<std::size_t>(last - first);
+  detail::BlockPartition<Storage, is_const> partition(
+      first, last, size < min_parallel_elements ? 1 : parts_per_worker * executor.concurrency());
+  std::vector<std::optional<T>> partials(partition.parts());
+  executor.run(partition.parts(), [&](std::size_t part) {
+    auto begin = first + static_cast<std::ptrdiff_t>(partition.offset(part));
+    auto end = first + static_cast<std::ptrdiff_t>(partition.offset(part + 1));
+    // 每段以自身首元素为初值，不需要单位元
+    partials[part].emplace(deque::accumulate(std::next(begin), end, T(*begin), op));
+  });
+  for (auto& partial : partials) {
+    init = op(std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+template <class Executor, class Storage, bool is_const, class T>
+T reduce(Executor& executor, detail::DequeIterator<Storage, is_const> first,
+         detail::DequeIterator<Storage, is_const> last, T init) {
+  return parallel::reduce(executor, first, last, std::move(init), std::plus<>());
+}
+
+template <class Storage, bool is_const, class T, class BinaryOperation>
+T reduce(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last, T init,
+         BinaryOperation op) {
+  return parallel::reduce(defaultPool(), first, last, std::move(init), std::move(op));
+}
+
+template <class Storage, bool is_const, class T>
+T reduce(detail::DequeIterator<Storage, is_const> first, detail::DequeIterator<Storage, is_const> last, T init) {
+  return parallel::reduce(defaultPool(), first, last, std::move(init), std::plus<>());
+}
+
+// One run per worker, each sorted in a contiguous scratch buffer, then merged
+// pairwise in parallel rounds. Needs value_type to be default constructible
+// (for the buffer) and move assignable.
+template <class Executor, class Storage, class Compare>
+void sort(Executor& executor, detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last,
+          Compare comp) {
+  detail::sortByRuns(executor, first, last, comp, [&](auto begin, auto end) { std::sort(begin, end, comp); });
+}
+
+template <class Executor, class Storage>
+void sort(Executor& executor, detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last) {
+  parallel::sort(executor, first, last, std::less<>());
+}
+
+template <class Storage, class Compare>
+void sort(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last, Compare comp) {
+  parallel::sort(defaultPool(), first, last, std::move(comp));
+}
+
+template <class Storage>
+void sort(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last) {
+  parallel::sort(defaultPool(), first, last, std::less<>());
+}
+
+// 与 sort 相同，但各段用 std::stable_sort，归并也保持相等元素的原有次序。
+template <class Executor, class Storage, class Compare>
+void stableSort(Executor& executor, detail::DequeIterator<Storage, false> first,
+                detail::DequeIterator<Storage, false> last, Compare comp) {
+  detail::sortByRuns(executor, first, last, comp, [&](auto begin, auto end) { std::stable_sort(begin, end, comp); });
+}
+
+template <class Executor, class Storage>
+void stableSort(Executor& executor, detail::DequeIterator<Storage, false> first,
+                detail::DequeIterator<Storage, false> last) {
+  parallel::stableSort(executor, first, last, std::less<>());
+}
+
+template <class Storage, class Compare>
+void stableSort(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last,
+                Compare comp) {
+  parallel::stableSort(defaultPool(), first, last, std::move(comp));
+}
+
+template <class Storage>
+void stableSort(detail::DequeIterator<Storage, false> first, detail::DequeIterator<Storage, false> last) {
+  parallel::stableSort(defaultPool(), first, last, std::less<>());
+}
+
+}  // namespace parallel
+
+}  // namespace deque
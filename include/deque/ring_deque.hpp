@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "deque/detail/memory.hpp"
+#include "deque/detail/storage.hpp"
+
+namespace deque {
+
+// 作为 RingDeque 的 Capacity 参数时表示容量在运行时给定。
+inline constexpr std::size_t dynamic_capacity = std::numeric_limits<std::size_t>::max();
+
+// 环满时 pushBack/pushFront 的行为：reject 要求调用者保证未满（tryPush* 返回 false），
+// overwrite 丢弃另一端的元素（pushBack 丢弃最旧的 front）。
+enum class OverflowPolicy { reject, overwrite };
+
+namespace detail {
+
+// Random access iterator over a ring: pos_ is the unmasked position, so
+// arithmetic and comparison are plain integer operations across the wrap point.
+template <class T, bool is_const>
+class RingIterator {
+ public:
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<is_const, const T&, T&>;
+  using pointer = std::conditional_t<is_const, const T*, T*>;
+  using iterator_category = std::random_access_iterator_tag;
+
+  RingIterator() = default;
+  RingIterator(T* data, std::size_t mask, std::size_t pos) noexcept : data_(data), mask_(mask), pos_(pos) {}
+
+  template <bool other_const, class = std::enable_if_t<is_const && !other_const>>
+  RingIterator(const RingIterator<T, other_const>& other) noexcept
+      : data_(other.data_), mask_(other.mask_), pos_(other.pos_) {}
+
+  reference operator*() const { return data_[pos_ & mask_]; }
+  pointer operator->() const { return data_ + (pos_ & mask_); }
+  reference operator[](difference_type n) const { return data_[(pos_ + static_cast<std::size_t>(n)) & mask_]; }
+
+  RingIterator& operator++() {
+    ++pos_;
+    return *this;
+  }
+  RingIterator operator++(int) {
+    RingIterator tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  RingIterator& operator--() {
+    --pos_;
+    return *this;
+  }
+  RingIterator operator--(int) {
+    RingIterator tmp = *this;
+    --pos_;
+    return tmp;
+  }
+
+  RingIterator& operator+=(difference_type n) {
+    pos_ += static_cast<std::size_t>(n);
+    return *this;
+  }
+  RingIterator& operator-=(difference_type n) {
+    pos_ -= static_cast<std::size_t>(n);
+    return *this;
+  }
+  RingIterator operator+(difference_type n) const { return RingIterator(data_, mask_, pos_ + static_cast<std::size_t>(n)); }
+  RingIterator operator-(difference_type n) const { return RingIterator(data_, mask_, pos_ - static_cast<std::size_t>(n)); }
+  friend RingIterator operator+(difference_type n, const RingIterator& it) { return it + n; }
+
+  difference_type operator-(const RingIterator& other) const {
+    return static_cast<difference_type>(pos_ - other.pos_);
+  }
+
+  bool operator==(const RingIterator& other) const { return pos_ == other.pos_; }
+  bool operator!=(const RingIterator& other) const { return pos_ != other.pos_; }
+  bool operator<(const RingIterator& other) const { return *this - other < 0; }
+  bool operator<=(const RingIterator& other) const { return !(other < *this); }
+  bool operator>(const RingIterator& other) const { return other < *this; }
+  bool operator>=(const RingIterator& other) const { return !(*this < other); }
+
+ private:
+  template <class, bool>
+  friend class RingIterator;
+
+  T* data_ = nullptr;
+  std::size_t mask_ = 0;
+  std::size_t pos_ = 0;
+};
+
+// 编译期容量：缓冲区就在对象内部，按 2 的幂向上取整以便用掩码定位。
+template <class T, std::size_t Capacity, class Allocator>
+class RingBuffer {
+ public:
+  static constexpr std::size_t physical_size = ceilPowerOfTwo(Capacity);
+
+  explicit RingBuffer(const Allocator& allocator) noexcept : allocator_(allocator) {}
+
+  T* data() noexcept { return std::launder(reinterpret_cast<T*>(bytes_)); }
+  const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(bytes_)); }
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+  static constexpr std::size_t mask() noexcept { return physical_size - 1; }
+  Allocator& allocator() noexcept { return allocator_; }
+  const Allocator& allocator() const noexcept { return allocator_; }
+
+ private:
+  alignas(T) unsigned char bytes_[physical_size * sizeof(T)];
+  Allocator allocator_;
+};
+
+// 运行期容量：构造时一次性从分配器申请 2 的幂大小的连续缓冲区，之后不再分配。
+// 容量为 0 时不持有缓冲区（被移动后的 RingDeque 处于这个状态）。
+template <class T, class Allocator>
+class RingBuffer<T, dynamic_capacity, Allocator> {
+ public:
+  using allocator_traits = std::allocator_traits<Allocator>;
+
+  explicit RingBuffer(const Allocator& allocator) noexcept : allocator_(allocator), capacity_(0), physical_size_(0) {}
+
+  RingBuffer(std::size_t capacity, const Allocator& allocator)
+      : allocator_(allocator), capacity_(capacity), physical_size_(capacity == 0 ? 0 : ceilPowerOfTwo(capacity)) {
+    if (capacity_ > 0) {
+      data_ = allocateBlock(allocator_, physical_size_);
+    }
+  }
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  ~RingBuffer() {
+    if (data_ != nullptr) {
+      deallocateBlock(allocator_, data_, physical_size_);
+    }
+  }
+
+  // 作用：只交换缓冲区与容量，分配器留在原处；调用者保证两个分配器相等，或随后用 swapAllocator 一起交换。
+  void swapStorage(RingBuffer& other) noexcept {
+    using std::swap;
+    swap(data_, other.data_);
+    swap(capacity_, other.capacity_);
+    swap(physical_size_, other.physical_size_);
+  }
+
+  void swapAllocator(RingBuffer& other) noexcept {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+  }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+  std::size_t mask() const noexcept { return physical_size_ - 1; }
+  Allocator& allocator() noexcept { return allocator_; }
+  const Allocator& allocator() const noexcept { return allocator_; }
+
+ private:
+  Allocator allocator_;
+  T* data_ = nullptr;
+  std::size_t capacity_;
+  std::size_t physical_size_;
+};
+
+}  // namespace detail
+
+// Bounded double-ended queue in one contiguous power-of-two buffer with
+// mask-based indexing; nothing is allocated after construction, moves included.
+// Capacity is the compile-time element limit (storage lives inside the object),
+// or dynamic_capacity to pass the limit to the constructor (see DynamicRingDeque).
+// The API mirrors Deque; when the ring is full the OverflowPolicy decides
+// whether a push is a precondition violation or overwrites the opposite end.
+template <class T, std::size_t Capacity, class Allocator = std::allocator<T>>
+class RingDeque {
+  static_assert(Capacity > 0, "RingDeque capacity must be positive");
+
+ public:
+  using value_type = T;
+  using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::RingIterator<T, false>;
+  using const_iterator = detail::RingIterator<T, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr bool is_dynamic = Capacity == dynamic_capacity;
+
+  template <bool dynamic = is_dynamic, class = std::enable_if_t<!dynamic>>
+  explicit RingDeque(OverflowPolicy policy = OverflowPolicy::reject) noexcept
+      : buffer_(allocator_type()), policy_(policy) {}
+
+  template <bool dynamic = is_dynamic, class = std::enable_if_t<dynamic>>
+  explicit RingDeque(size_type capacity, OverflowPolicy policy = OverflowPolicy::reject,
+                     const allocator_type& allocator = allocator_type())
+      : buffer_(capacity, allocator), policy_(policy) {
+    assert(capacity > 0);
+  }
+
+  RingDeque(const RingDeque& other)
+      : RingDeque(other, allocator_traits::select_on_container_copy_construction(other.buffer_.allocator())) {
+    copyFrom_(other);
+  }
+
+  // 动态容量时直接接管 other 的缓冲区，不分配：被移动的对象容量变为 0，
+  // 此时 tryPush* 返回 false，push*/emplace* 是前置条件错误；赋值后可以继续使用。
+  RingDeque(RingDeque&& other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>)
+      : buffer_(other.buffer_.allocator()), policy_(other.policy_) {
+    if constexpr (is_dynamic) {
+      swapContents_(other);
+    } else {
+      moveFrom_(other);
+    }
+  }
+
+  // 动态容量时 propagate_on_container_copy_assignment 为真则连同分配器一起复制，
+  // 否则副本的缓冲区从自己的分配器申请；先构造好副本再交换，保证强异常安全。
+  RingDeque& operator=(const RingDeque& other) {
+    if (this != &other) {
+      if constexpr (is_dynamic) {
+        RingDeque copy(other, propagate_on_copy_assignment::value ? other.buffer_.allocator() : allocator_());
+        copy.copyFrom_(other);
+        if constexpr (propagate_on_copy_assignment::value) {
+          buffer_.swapAllocator(copy.buffer_);
+        }
+        swapContents_(copy);
+      } else {
+        RingDeque copy(other);
+        swap(copy);
+      }
+    }
+    return *this;
+  }
+
+  // 动态容量时只有分配器随移动传播或两者相等才能接管 other 的缓冲区；
+  // 否则从自己的分配器申请同样容量的缓冲区，逐个移动元素。
+  RingDeque& operator=(RingDeque&& other) noexcept(is_dynamic ? propagate_on_move_assignment::value ||
+                                                                    allocator_traits::is_always_equal::value
+                                                              : std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      if constexpr (is_dynamic) {
+        if constexpr (propagate_on_move_assignment::value) {
+          buffer_.swapAllocator(other.buffer_);
+          swapContents_(other);
+        } else {
+          if (allocator_() == other.allocator_()) {
+            swapContents_(other);
+          } else {
+            RingDeque moved(other, allocator_());
+            moved.moveFrom_(other);
+            swapContents_(moved);
+          }
+        }
+      } else {
+        policy_ = other.policy_;
+        moveFrom_(other);
+      }
+    }
+    return *this;
+  }
+
+  ~RingDeque() { clear(); }
+
+  // 动态容量时交换缓冲区指针：propagate_on_container_swap 为假时分配器留在原处，此时要求两个分配器相等。
+  // 编译期容量时元素存放在对象内部，只能经由临时对象逐个移动。
+  void swap(RingDeque& other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_dynamic) {
+      if constexpr (allocator_traits::propagate_on_container_swap::value) {
+        buffer_.swapAllocator(other.buffer_);
+      } else {
+        assert(allocator_() == other.allocator_());
+      }
+      swapContents_(other);
+    } else {
+      RingDeque tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  bool full() const noexcept { return size_ == capacity(); }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return buffer_.capacity(); }
+
+  allocator_type getAllocator() const noexcept { return allocator_(); }
+
+  OverflowPolicy overflowPolicy() const noexcept { return policy_; }
+  void setOverflowPolicy(OverflowPolicy policy) noexcept { policy_ = policy; }
+
+  void clear() noexcept {
+    if constexpr (!detail::is_trivially_destroyable_v<allocator_type, T>) {
+      while (size_ > 0) {
+        popBack();
+      }
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+
+  iterator begin() noexcept { return iterator(buffer_.data(), buffer_.mask(), head_); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator cbegin() const noexcept { return const_iterator(data_(), buffer_.mask(), head_); }
+
+  iterator end() noexcept { return iterator(buffer_.data(), buffer_.mask(), head_ + size_); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cend() const noexcept { return const_iterator(data_(), buffer_.mask(), head_ + size_); }
+
+  reverse_iterator rBegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rBegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rEnd() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rEnd() const noexcept { return const_reverse_iterator(begin()); }
+
+  reference operator[](size_type index) {
+    assert(index < size_);
+    return *slot_(head_ + index);
+  }
+  const_reference operator[](size_type index) const {
+    assert(index < size_);
+    return data_()[(head_ + index) & buffer_.mask()];
+  }
+
+  reference front() {
+    assert(size_ > 0);
+    return (*this)[0];
+  }
+  const_reference front() const {
+    assert(size_ > 0);
+    return (*this)[0];
+  }
+  reference back() {
+    assert(size_ > 0);
+    return (*this)[size_ - 1];
+  }
+  const_reference back() const {
+    assert(size_ > 0);
+    return (*this)[size_ - 1];
+  }
+
+  void pushBack(const value_type& value) { emplaceBack(value); }
+  void pushBack(value_type&& value) { emplaceBack(std::move(value)); }
+  void pushFront(const value_type& value) { emplaceFront(value); }
+  void pushFront(value_type&& value) { emplaceFront(std::move(value)); }
+
+  // 环满时：reject 策略下是前置条件错误；overwrite 策略下先丢弃 front。
+  template <class... Args>
+  reference emplaceBack(Args&&... args) {
+    if (full()) {
+      return overwrite_(/*at_back=*/true, std::forward<Args>(args)...);
+    }
+    T* slot = slot_(head_ + size_);
+    detail::constructAt(allocator_(), slot, std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  // 环满时：reject 策略下是前置条件错误；overwrite 策略下先丢弃 back。
+  template <class... Args>
+  reference emplaceFront(Args&&... args) {
+    if (full()) {
+      return overwrite_(/*at_back=*/false, std::forward<Args>(args)...);
+    }
+    T* slot = slot_(head_ - 1);
+    detail::constructAt(allocator_(), slot, std::forward<Args>(args)...);
+    head_ = (head_ - 1) & buffer_.mask();
+    ++size_;
+    return *slot;
+  }
+
+  // 作用：未满时推入并返回 true；已满时不论策略都不修改并返回 false。
+  bool tryPushBack(const value_type& value) { return !full() && (emplaceBack(value), true); }
+  bool tryPushBack(value_type&& value) { return !full() && (emplaceBack(std::move(value)), true); }
+  bool tryPushFront(const value_type& value) { return !full() && (emplaceFront(value), true); }
+  bool tryPushFront(value_type&& value) { return !full() && (emplaceFront(std::move(value)), true); }
+
+  void popBack() {
+    assert(size_ > 0);
+    detail::destroyAt(allocator_(), slot_(head_ + size_ - 1));
+    --size_;
+  }
+
+  void popFront() {
+    assert(size_ > 0);
+    detail::destroyAt(allocator_(), slot_(head_));
+    head_ = (head_ + 1) & buffer_.mask();
+    --size_;
+  }
+
+  friend bool operator==(const RingDeque& lhs, const RingDeque& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const RingDeque& lhs, const RingDeque& rhs) { return !(lhs == rhs); }
+  friend bool operator<(const RingDeque& lhs, const RingDeque& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  friend bool operator<=(const RingDeque& lhs, const RingDeque& rhs) { return !(rhs < lhs); }
+  friend bool operator>(const RingDeque& lhs, const RingDeque& rhs) { return rhs < lhs; }
+  friend bool operator>=(const RingDeque& lhs, const RingDeque& rhs) { return !(lhs < rhs); }
+
+ private:
+  using buffer_type = detail::RingBuffer<T, Capacity, allocator_type>;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+  using propagate_on_copy_assignment = typename allocator_traits::propagate_on_container_copy_assignment;
+  using propagate_on_move_assignment = typename allocator_traits::propagate_on_container_move_assignment;
+
+  // 作用：按 other 的容量与策略、使用 allocator 构造一个空环，供拷贝/移动委托使用。
+  RingDeque(const RingDeque& other, const allocator_type& allocator)
+      : buffer_(makeBuffer_(other, allocator)), policy_(other.policy_) {}
+
+  static buffer_type makeBuffer_(const RingDeque& other, const allocator_type& allocator) {
+    if constexpr (is_dynamic) {
+      return buffer_type(other.capacity(), allocator);
+    } else {
+      return buffer_type(allocator);
+    }
+  }
+
+  // 作用：交换缓冲区、游标与策略，分配器留在原处（只用于动态容量）。
+  void swapContents_(RingDeque& other) noexcept {
+    buffer_.swapStorage(other.buffer_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(policy_, other.policy_);
+  }
+
+  void copyFrom_(const RingDeque& other) {
+    for (const auto& value : other) {
+      emplaceBack(value);
+    }
+  }
+
+  void moveFrom_(RingDeque& other) {
+    for (auto& value : other) {
+      emplaceBack(std::move(value));
+    }
+    other.clear();
+  }
+
+  // 作用：环满时的 overwrite 路径。参数可能引用即将被丢弃的元素（如 pushBack(front())），
+  // 所以先构造临时对象，再丢弃另一端并移入。
+  template <class... Args>
+  reference overwrite_(bool at_back, Args&&... args) {
+    assert(policy_ == OverflowPolicy::overwrite && capacity() > 0);
+    T value(std::forward<Args>(args)...);
+    if (at_back) {
+      popFront();
+      return emplaceBack(std::move(value));
+    }
+    popBack();
+    return emplaceFront(std::move(value));
+  }
+
+  T* slot_(size_type position) noexcept { return buffer_.data() + (position & buffer_.mask()); }
+  T* data_() const noexcept { return const_cast<T*>(buffer_.data()); }
+
+  allocator_type& allocator_() noexcept { return buffer_.allocator(); }
+  const allocator_type& allocator_() const noexcept { return buffer_.allocator(); }
+
+  buffer_type buffer_;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  OverflowPolicy policy_;
+};
+
+template <class T, std::size_t Capacity, class Allocator>
+inline void swap(RingDeque<T, Capacity, Allocator>& lhs, RingDeque<T, Capacity, Allocator>& rhs) noexcept(
+    noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// 容量在构造时给定的 RingDeque。
+template <class T, class Allocator = std::allocator<T>>
+using DynamicRingDeque = RingDeque<T, dynamic_capacity, Allocator>;
+
+}  // namespace deque
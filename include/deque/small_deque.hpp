@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "deque/deque.hpp"
+#include "deque/detail/index_iterator.hpp"
+#include "deque/ring_deque.hpp"
+
+namespace deque {
+
+// Deque with inline storage for the first InlineN elements.
+// Up to InlineN elements live in a RingDeque inside the object, so empty
+// construction and small workloads never touch the allocator. The first push
+// beyond InlineN moves everything into a segmented Deque; once that Deque is
+// drained the container drops back to the inline ring, keeping the Deque (and
+// its cached blocks) for the next spill.
+template <class T, std::size_t InlineN, class Allocator = std::allocator<T>,
+          std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class SmallDeque {
+  static_assert(InlineN > 0, "SmallDeque needs at least one inline slot");
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::IndexIterator<SmallDeque, false>;
+  using const_iterator = detail::IndexIterator<SmallDeque, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using heap_type = Deque<T, Allocator, BlockSize>;
+
+  static constexpr size_type inline_capacity = InlineN;
+
+  SmallDeque() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) : allocator_() {}
+  explicit SmallDeque(const allocator_type& allocator) noexcept : allocator_(allocator) {}
+
+  SmallDeque(const SmallDeque& other)
+      : SmallDeque(other, allocator_traits::select_on_container_copy_construction(other.allocator_)) {}
+
+  SmallDeque(const SmallDeque& other, const allocator_type& allocator) : allocator_(allocator) {
+    if (other.spilled_) {
+      heap_.emplace(*other.heap_, allocator_);
+      spilled_ = true;
+    } else {
+      inline_ = other.inline_;
+    }
+  }
+
+  SmallDeque(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : inline_(std::move(other.inline_)), allocator_(other.allocator_), heap_(std::move(other.heap_)),
+        spilled_(other.spilled_) {
+    other.heap_.reset();
+    other.spilled_ = false;
+  }
+
+  // propagate_on_container_copy_assignment 为真时连同分配器一起复制，否则副本使用自己的分配器；
+  // 先在副本中构造好再交换，保证强异常安全。
+  SmallDeque& operator=(const SmallDeque& other) {
+    if (this != &other) {
+      SmallDeque copy(other, propagate_on_copy_assignment::value ? other.allocator_ : allocator_);
+      if constexpr (propagate_on_copy_assignment::value) {
+        swapAllocators_(copy);
+      }
+      swapContents_(copy);
+    }
+    return *this;
+  }
+
+  // 分配器随移动传播或两者相等时直接接管 other 的溢出 Deque；否则按自己的分配器逐个移动元素。
+  SmallDeque& operator=(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                     (propagate_on_move_assignment::value ||
+                                                      allocator_traits::is_always_equal::value)) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (propagate_on_move_assignment::value) {
+      SmallDeque moved(std::move(other));
+      swapAllocators_(moved);
+      swapContents_(moved);
+    } else {
+      if (allocator_ == other.allocator_) {
+        SmallDeque moved(std::move(other));
+        swapContents_(moved);
+      } else {
+        SmallDeque moved(allocator_);
+        if (other.spilled_) {
+          moved.heap_.emplace(std::move(*other.heap_), allocator_);
+          moved.spilled_ = true;
+        } else {
+          moved.inline_ = std::move(other.inline_);
+        }
+        other.clear();
+        swapContents_(moved);
+      }
+    }
+    return *this;
+  }
+
+  ~SmallDeque() = default;
+
+  // propagate_on_container_swap 为假时分配器留在原处，此时要求两个分配器相等。
+  void swap(SmallDeque& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (allocator_traits::propagate_on_container_swap::value) {
+      swapAllocators_(other);
+    } else {
+      assert(allocator_ == other.allocator_);
+    }
+    swapContents_(other);
+  }
+
+  allocator_type getAllocator() const noexcept { return allocator_; }
+
+  // 作用：元素是否仍保存在对象内部的环形缓冲区中。
+  bool isInline() const noexcept { return !spilled_; }
+
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept { return spilled_ ? heap_->size() : inline_.size(); }
+
+  // 清空后回到内联模式；已溢出的 Deque 保留下来以复用其块缓存。
+  void clear() noexcept {
+    inline_.clear();
+    if (spilled_) {
+      heap_->clear();
+      spilled_ = false;
+    }
+  }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size()); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cend() const noexcept { return const_iterator(this, size()); }
+
+  reverse_iterator rBegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rBegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rEnd() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rEnd() const noexcept { return const_reverse_iterator(begin()); }
+
+  reference operator[](size_type index) { return spilled_ ? (*heap_)[index] : inline_[index]; }
+  const_reference operator[](size_type index) const { return spilled_ ? (*heap_)[index] : inline_[index]; }
+
+  reference front() { return spilled_ ? heap_->front() : inline_.front(); }
+  const_reference front() const { return spilled_ ? heap_->front() : inline_.front(); }
+  reference back() { return spilled_ ? heap_->back() : inline_.back(); }
+  const_reference back() const { return spilled_ ? heap_->back() : inline_.back(); }
+
+  void pushBack(const value_type& value) { emplaceBack(value); }
+  void pushBack(value_type&& value) { emplaceBack(std::move(value)); }
+  void pushFront(const value_type& value) { emplaceFront(value); }
+  void pushFront(value_type&& value) { emplaceFront(std::move(value)); }
+
+  template <class... Args>
+  reference emplaceBack(Args&&... args) {
+    if (!spilled_) {
+      if (!inline_.full()) {
+        return inline_.emplaceBack(std::forward<Args>(args)...);
+      }
+      // 参数可能引用内联元素，先构造再搬迁。
+      T value(std::forward<Args>(args)...);
+      spill_();
+      return heap_->emplaceBack(std::move(value));
+    }
+    return heap_->emplaceBack(std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  reference emplaceFront(Args&&... args) {
+    if (!spilled_) {
+      if (!inline_.full()) {
+        return inline_.emplaceFront(std::forward<Args>(args)...);
+      }
+      T value(std::forward<Args>(args)...);
+      spill_();
+      return heap_->emplaceFront(std::move(value));
+    }
+    return heap_->emplaceFront(std::forward<Args>(args)...);
+  }
+
+  void popBack() {
+    if (!spilled_) {
+      inline_.popBack();
+      return;
+    }
+    heap_->popBack();
+    dropBackIfDrained_();
+  }
+
+  void popFront() {
+    if (!spilled_) {
+      inline_.popFront();
+      return;
+    }
+    heap_->popFront();
+    dropBackIfDrained_();
+  }
+
+  friend bool operator==(const SmallDeque& lhs, const SmallDeque& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const SmallDeque& lhs, const SmallDeque& rhs) { return !(lhs == rhs); }
+  friend bool operator<(const SmallDeque& lhs, const SmallDeque& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  friend bool operator<=(const SmallDeque& lhs, const SmallDeque& rhs) { return !(rhs < lhs); }
+  friend bool operator>(const SmallDeque& lhs, const SmallDeque& rhs) { return rhs < lhs; }
+  friend bool operator>=(const SmallDeque& lhs, const SmallDeque& rhs) { return !(lhs < rhs); }
+
+ private:
+  using allocator_traits = std::allocator_traits<allocator_type>;
+  using propagate_on_copy_assignment = typename allocator_traits::propagate_on_container_copy_assignment;
+  using propagate_on_move_assignment = typename allocator_traits::propagate_on_container_move_assignment;
+
+  // 作用：交换除分配器之外的全部状态。
+  void swapContents_(SmallDeque& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    using std::swap;
+    swap(inline_, other.inline_);
+    swap(heap_, other.heap_);
+    swap(spilled_, other.spilled_);
+  }
+
+  void swapAllocators_(SmallDeque& other) noexcept {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+  }
+
+  // 作用：把内联元素整体搬到分段 Deque 中，之后所有操作都转发给它。
+  // 先一次预留全部块，移动不会抛出异常的元素随后的搬移不会失败；移动可能抛出时改为复制
+  // （同 std::move_if_noexcept）。失败时清空已搬入的部分，内联元素保持原样。
+  void spill_() {
+    if (!heap_) {
+      heap_.emplace(allocator_);
+    }
+    assert(heap_->empty());
+    try {
+      heap_->reserveBack(inline_.size());
+      if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        heap_->append(std::make_move_iterator(inline_.begin()), std::make_move_iterator(inline_.end()));
+      } else {
+        heap_->append(inline_.begin(), inline_.end());
+      }
+    } catch (...) {
+      heap_->clear();
+      throw;
+    }
+    inline_.clear();
+    spilled_ = true;
+  }
+
+  // 作用：溢出后的 Deque 被取空时回到内联模式。
+  void dropBackIfDrained_() noexcept {
+    if (heap_->empty()) {
+      spilled_ = false;
+    }
+  }
+
+  RingDeque<T, InlineN> inline_;
+  allocator_type allocator_;
+  std::optional<heap_type> heap_;
+  bool spilled_ = false;
+};
+
+template <class T, std::size_t InlineN, class Allocator, std::size_t BlockSize>
+inline void swap(SmallDeque<T, InlineN, Allocator, BlockSize>& lhs,
+                 SmallDeque<T, InlineN, Allocator, BlockSize>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+}  // namespace deque
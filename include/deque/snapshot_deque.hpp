@@ -0,0 +1,534 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "deque/detail/iterator.hpp"
+#include "deque/detail/memory.hpp"
+#include "deque/detail/segment.hpp"
+#include "deque/detail/storage.hpp"
+
+namespace deque {
+
+namespace detail {
+
+// SnapshotDeque 的块：BlockSize 个元素槽位之后紧跟引用计数和已构造区间。
+// 槽位放在最前面，映射数组里存的元素指针可以直接换回块指针。
+template <class T, std::size_t BlockSize>
+struct SharedBlock {
+  alignas(T) unsigned char slots[sizeof(T) * BlockSize];
+  std::atomic<std::size_t> refs{1};  // 共享该块的容器数
+  std::size_t first = 0;             // 已构造元素的槽位区间 [first, last)
+  std::size_t last = 0;
+};
+
+}  // namespace detail
+
+// Deque whose copies share blocks: snapshot() (and the copy constructor)
+// copies only the block map and bumps a reference count per block, so a
+// snapshot of an n-element deque costs O(n / BlockSize). Shared blocks are
+// immutable; the first write a container makes into one of them copies just
+// that block (copy-on-write at block granularity).
+//
+// The layout is the one SegmentedStorage uses — fixed-size blocks, a map of
+// block pointers, start/finish cursors — and iteration uses the same
+// DequeIterator, so the segmented and parallel algorithms accept snapshots.
+// Iterators are read-only. The non-const operator[], front() and back()
+// unshare the block they touch and return a writable reference, which must
+// not be used after the next snapshot() or copy of this container.
+//
+// A snapshot may be read and destroyed on another thread while the original
+// keeps changing: reference counts are atomic and a container only ever
+// writes to blocks it owns exclusively.
+template <class T, class Allocator = std::allocator<T>, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class SnapshotDeque {
+  static_assert(BlockSize > 0, "BlockSize must be positive");
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_iterator = detail::DequeIterator<SnapshotDeque, true>;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+  using const_segment = detail::Span<const T>;
+  using const_segment_range = detail::SegmentRange<SnapshotDeque, true>;
+
+  static constexpr size_type block_size = BlockSize;
+  static constexpr size_type initial_map_capacity = 8;
+
+  struct BlockStats {
+    size_type block_allocations = 0;  // 向分配器申请的块数（含写时复制）
+    size_type block_copies = 0;       // 写入共享块时复制出的块数
+    size_type map_allocations = 0;    // 映射数组的分配次数
+  };
+
+  SnapshotDeque() noexcept(std::is_nothrow_default_constructible_v<allocator_type>)
+      : map_allocator_(allocator_), block_allocator_(allocator_) {}
+
+  explicit SnapshotDeque(const allocator_type& allocator) noexcept
+      : allocator_(allocator), map_allocator_(allocator_), block_allocator_(allocator_) {}
+
+  template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  SnapshotDeque(InputIt first, InputIt last, const allocator_type& allocator = allocator_type())
+      : SnapshotDeque(allocator) {
+    for (; first != last; ++first) {
+      emplaceBack(*first);
+    }
+  }
+
+  // 拷贝与 snapshot() 相同，共享全部块；只有分配器不相等时（例如 pmr 拷贝回到默认资源）才逐个复制元素。
+  SnapshotDeque(const SnapshotDeque& other)
+      : SnapshotDeque(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+    assignFrom_(other);
+  }
+
+  SnapshotDeque(SnapshotDeque&& other) noexcept
+      : SnapshotDeque(other.allocator_) {
+    swapContents_(other);
+  }
+
+  SnapshotDeque& operator=(const SnapshotDeque& other) {
+    if (this != &other) {
+      SnapshotDeque copy(propagate_on_copy_assignment::value ? other.allocator_ : allocator_);
+      copy.assignFrom_(other);
+      if constexpr (propagate_on_copy_assignment::value) {
+        swapAllocators_(copy);
+      }
+      swapContents_(copy);
+    }
+    return *this;
+  }
+
+  SnapshotDeque& operator=(SnapshotDeque&& other) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (propagate_on_move_assignment::value) {
+      SnapshotDeque moved(std::move(other));
+      swapAllocators_(moved);
+      swapContents_(moved);
+    } else {
+      // 分配器不相等时不能接管对方的块，只能按自己的分配器复制。
+      SnapshotDeque moved(allocator_);
+      if (allocator_ == other.allocator_) {
+        moved.swapContents_(other);
+      } else {
+        moved.assignFrom_(other);
+        other.clear();
+      }
+      swapContents_(moved);
+    }
+    return *this;
+  }
+
+  ~SnapshotDeque() { clear(); }
+
+  // 分配器不传播时要求两边的分配器相等，与 Deque::swap 相同。
+  void swap(SnapshotDeque& other) noexcept {
+    if constexpr (allocator_traits::propagate_on_container_swap::value) {
+      swapAllocators_(other);
+    } else {
+      assert(allocator_ == other.allocator_);
+    }
+    swapContents_(other);
+  }
+
+  allocator_type getAllocator() const noexcept { return allocator_; }
+
+  // 作用：返回与当前内容相同的快照，与本容器共享全部块，代价与块数成正比。
+  SnapshotDeque snapshot() const {
+    SnapshotDeque copy(allocator_);
+    copy.shareFrom_(*this);
+    return copy;
+  }
+
+  bool empty() const noexcept { return start_ == finish_; }
+  size_type size() const noexcept { return finish_ - start_; }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_reverse_iterator rBegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rEnd() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_segment_range segments() const noexcept { return const_segment_range(begin(), end()); }
+
+  const_reference operator[](size_type index) const {
+    assert(index < size());
+    size_type position = start_ + index;
+    return map_[position / block_size][position % block_size];
+  }
+  const_reference front() const { return (*this)[0]; }
+  const_reference back() const { return (*this)[size() - 1]; }
+
+  // 作用：返回可写引用；元素所在的块与其他快照共享时先复制这一块。
+  reference operator[](size_type index) {
+    assert(index < size());
+    size_type position = start_ + index;
+    return prepareWrite_(position / block_size)[position % block_size];
+  }
+  reference front() { return (*this)[0]; }
+  reference back() { return (*this)[size() - 1]; }
+
+  void pushBack(const value_type& value) { emplaceBack(value); }
+  void pushBack(value_type&& value) { emplaceBack(std::move(value)); }
+  void pushFront(const value_type& value) { emplaceFront(value); }
+  void pushFront(value_type&& value) { emplaceFront(std::move(value)); }
+
+  // 作用：在末尾构造新元素；finish 所在块与其他快照共享时先复制这一块。
+  template <class... Args>
+  reference emplaceBack(Args&&... args) {
+    ensureMap_();
+    if (finish_ / block_size + 1 >= map_capacity_) {
+      growMap_();
+    }
+    size_type block_index = finish_ / block_size;
+    size_type offset = finish_ % block_size;
+    T* data = prepareWrite_(block_index);
+    // finish 所在块必须始终存在（end() 迭代器指向它），填满当前块前先备好下一块。
+    T* next = nullptr;
+    if (offset + 1 == block_size) {
+      assert(map_[block_index + 1] == nullptr);
+      next = acquireBlock_();
+    }
+    try {
+      detail::constructAt(allocator_, data + offset, std::forward<Args>(args)...);
+    } catch (...) {
+      if (next != nullptr) {
+        releaseBlock_(next);
+      }
+      throw;
+    }
+    if (next != nullptr) {
+      map_[block_index + 1] = next;
+    }
+    blockOf_(data)->last = offset + 1;
+    ++finish_;
+    return data[offset];
+  }
+
+  // 作用：在前端构造新元素；跨进新块时直接使用新块，否则先确保 start 所在块由本容器独占。
+  template <class... Args>
+  reference emplaceFront(Args&&... args) {
+    ensureMap_();
+    if (start_ / block_size == 0) {
+      growMap_();
+    }
+    size_type offset = start_ % block_size;
+    if (offset == 0) {
+      size_type block_index = start_ / block_size - 1;
+      assert(map_[block_index] == nullptr);
+      T* data = acquireBlock_();
+      try {
+        detail::constructAt(allocator_, data + block_size - 1, std::forward<Args>(args)...);
+      } catch (...) {
+        releaseBlock_(data);
+        throw;
+      }
+      blockOf_(data)->first = block_size - 1;
+      blockOf_(data)->last = block_size;
+      map_[block_index] = data;
+      --start_;
+      return data[block_size - 1];
+    }
+    T* data = prepareWrite_(start_ / block_size);
+    detail::constructAt(allocator_, data + offset - 1, std::forward<Args>(args)...);
+    blockOf_(data)->first = offset - 1;
+    --start_;
+    return data[offset - 1];
+  }
+
+  // 弹出共享块中的元素只移动游标，元素留给仍在使用它的快照；独占块中的元素立即析构。
+  void popBack() {
+    assert(!empty());
+    size_type old_block = finish_ / block_size;
+    --finish_;
+    size_type block_index = finish_ / block_size;
+    if (block_index != old_block) {
+      releaseBlock_(std::exchange(map_[old_block], nullptr));
+    }
+    if (exclusive_(map_[block_index])) {
+      trimToView_(block_index);
+    }
+  }
+
+  void popFront() {
+    assert(!empty());
+    size_type old_block = start_ / block_size;
+    ++start_;
+    if (start_ / block_size != old_block) {
+      releaseBlock_(std::exchange(map_[old_block], nullptr));
+    } else if (exclusive_(map_[old_block])) {
+      trimToView_(old_block);
+    }
+  }
+
+  // 作用：放弃本容器对所有块的引用并释放映射数组；其他快照不受影响。
+  void clear() noexcept {
+    if (map_ == nullptr) {
+      return;
+    }
+    for (size_type i = start_ / block_size; i <= finish_ / block_size; ++i) {
+      releaseBlock_(map_[i]);
+    }
+    map_allocator_traits::deallocate(map_allocator_, map_, map_capacity_);
+    map_ = nullptr;
+    map_capacity_ = 0;
+    start_ = 0;
+    finish_ = 0;
+  }
+
+  BlockStats blockStats() const noexcept { return stats_; }
+
+  // 作用：返回当前与其他容器共享的块数（线性扫描映射数组）。
+  size_type sharedBlocks() const noexcept {
+    if (map_ == nullptr) {
+      return 0;
+    }
+    size_type shared = 0;
+    for (size_type i = start_ / block_size; i <= finish_ / block_size; ++i) {
+      shared += exclusive_(map_[i]) ? 0 : 1;
+    }
+    return shared;
+  }
+
+  friend bool operator==(const SnapshotDeque& lhs, const SnapshotDeque& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const SnapshotDeque& lhs, const SnapshotDeque& rhs) { return !(lhs == rhs); }
+
+ private:
+  friend const_iterator;
+
+  using Block = detail::SharedBlock<T, BlockSize>;
+  using element_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using allocator_traits = std::allocator_traits<element_allocator_type>;
+  using map_allocator_type = typename allocator_traits::template rebind_alloc<T*>;
+  using map_allocator_traits = std::allocator_traits<map_allocator_type>;
+  using block_allocator_type = typename allocator_traits::template rebind_alloc<Block>;
+  using block_allocator_traits = std::allocator_traits<block_allocator_type>;
+  using propagate_on_copy_assignment = typename allocator_traits::propagate_on_container_copy_assignment;
+  using propagate_on_move_assignment = typename allocator_traits::propagate_on_container_move_assignment;
+
+  static_assert(std::is_standard_layout_v<Block>, "SharedBlock must start with its slots");
+
+  // DequeIterator 通过以下接口在块之间移动，与 SegmentedStorage 的同名接口含义相同。
+  struct Location {
+    size_type block_index;
+    size_type offset;
+  };
+
+  Location locate(size_type index) const noexcept {
+    assert(index <= size());
+    size_type position = start_ + index;
+    return {position / block_size, position % block_size};
+  }
+  T* const* blockSlot(size_type block_index) const noexcept {
+    assert(block_index < map_capacity_);
+    return map_ + block_index;
+  }
+  bool hasMap() const noexcept { return map_ != nullptr; }
+  size_type indexOf(T* const* slot, size_type offset) const noexcept {
+    return static_cast<size_type>(slot - map_) * block_size + offset - start_;
+  }
+
+  static Block* blockOf_(T* data) noexcept { return reinterpret_cast<Block*>(data); }
+
+  static bool exclusive_(T* data) noexcept {
+    return blockOf_(data)->refs.load(std::memory_order_acquire) == 1;
+  }
+
+  // 作用：分配一个引用计数为 1、不含元素的块，返回其首个槽位。
+  T* acquireBlock_() {
+    Block* block = block_allocator_traits::allocate(block_allocator_, 1);
+    ::new (static_cast<void*>(block)) Block;
+    ++stats_.block_allocations;
+    return reinterpret_cast<T*>(block->slots);
+  }
+
+  // 作用：放弃对块的一份引用；最后一个持有者负责析构已构造的元素并归还块。
+  void releaseBlock_(T* data) noexcept {
+    Block* block = blockOf_(data);
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      detail::destroyN(allocator_, data + block->first, block->last - block->first);
+      block->~Block();
+      block_allocator_traits::deallocate(block_allocator_, block, 1);
+    }
+  }
+
+  // 作用：返回第 block_index 块中属于本容器的槽位区间。
+  std::pair<size_type, size_type> viewOf_(size_type block_index) const noexcept {
+    size_type base = block_index * block_size;
+    size_type first = std::max(start_, base) - base;
+    size_type last = std::min(finish_, base + block_size) - base;
+    return {first, std::max(first, last)};
+  }
+
+  // 作用：独占块的已构造区间可能大于本容器的视图（其他快照释放后遗留的元素），析构视图之外的部分。
+  void trimToView_(size_type block_index) noexcept {
+    T* data = map_[block_index];
+    Block* block = blockOf_(data);
+    auto [first, last] = viewOf_(block_index);
+    if (first == last) {
+      detail::destroyN(allocator_, data + block->first, block->last - block->first);
+    } else {
+      assert(block->first <= first && last <= block->last);
+      detail::destroyN(allocator_, data + block->first, first - block->first);
+      detail::destroyN(allocator_, data + last, block->last - last);
+    }
+    block->first = first;
+    block->last = last;
+  }
+
+  // 作用：确保第 block_index 块由本容器独占并返回它：共享时复制视图内的元素到新块，独占时整理已构造区间。
+  T* prepareWrite_(size_type block_index) {
+    T* data = map_[block_index];
+    if (exclusive_(data)) {
+      trimToView_(block_index);
+      return data;
+    }
+    auto [first, last] = viewOf_(block_index);
+    T* copy = acquireBlock_();
+    try {
+      detail::uninitializedCopyN(allocator_, static_cast<const T*>(data + first), last - first, copy + first);
+    } catch (...) {
+      releaseBlock_(copy);
+      throw;
+    }
+    blockOf_(copy)->first = first;
+    blockOf_(copy)->last = last;
+    ++stats_.block_copies;
+    map_[block_index] = copy;
+    releaseBlock_(data);
+    return copy;
+  }
+
+  T** newMap_(size_type capacity) {
+    T** map = map_allocator_traits::allocate(map_allocator_, capacity);
+    ++stats_.map_allocations;
+    std::fill_n(map, capacity, nullptr);
+    return map;
+  }
+
+  // 作用：第一次插入时建立映射数组和中心块，游标停在块的中间。
+  void ensureMap_() {
+    if (map_ != nullptr) {
+      return;
+    }
+    T** map = newMap_(initial_map_capacity);
+    size_type center = initial_map_capacity / 2;
+    try {
+      map[center] = acquireBlock_();
+    } catch (...) {
+      map_allocator_traits::deallocate(map_allocator_, map, initial_map_capacity);
+      throw;
+    }
+    map_ = map;
+    map_capacity_ = initial_map_capacity;
+    start_ = center * block_size + block_size / 2;
+    finish_ = start_;
+  }
+
+  // 作用：映射数组两端至少各留一个空槽；足够稀疏时原地居中，否则按两倍重新分配。
+  void growMap_() {
+    size_type first = start_ / block_size;
+    size_type last = finish_ / block_size;
+    size_type used = last - first + 1;
+    size_type needed = 2 * (used + 1);
+    size_type capacity = map_capacity_ >= needed ? map_capacity_ : std::max(initial_map_capacity, needed);
+    size_type new_begin = (capacity - used) / 2;
+    if (capacity == map_capacity_) {
+      if (new_begin < first) {
+        std::copy(map_ + first, map_ + last + 1, map_ + new_begin);
+      } else {
+        std::copy_backward(map_ + first, map_ + last + 1, map_ + new_begin + used);
+      }
+      std::fill(map_, map_ + new_begin, nullptr);
+      std::fill(map_ + new_begin + used, map_ + map_capacity_, nullptr);
+    } else {
+      T** map = newMap_(capacity);
+      std::copy(map_ + first, map_ + last + 1, map + new_begin);
+      map_allocator_traits::deallocate(map_allocator_, map_, map_capacity_);
+      map_ = map;
+      map_capacity_ = capacity;
+    }
+    start_ = start_ - first * block_size + new_begin * block_size;
+    finish_ = finish_ - first * block_size + new_begin * block_size;
+  }
+
+  // 作用：空容器与 other 共享全部块：复制映射数组并为每块增加一次引用。
+  void shareFrom_(const SnapshotDeque& other) {
+    assert(map_ == nullptr);
+    assert(allocator_ == other.allocator_);
+    if (other.map_ == nullptr) {
+      return;
+    }
+    map_ = newMap_(other.map_capacity_);
+    map_capacity_ = other.map_capacity_;
+    for (size_type i = other.start_ / block_size; i <= other.finish_ / block_size; ++i) {
+      blockOf_(other.map_[i])->refs.fetch_add(1, std::memory_order_relaxed);
+      map_[i] = other.map_[i];
+    }
+    start_ = other.start_;
+    finish_ = other.finish_;
+  }
+
+  // 作用：空容器取得 other 的内容：分配器相等时共享块，否则逐个复制元素。
+  void assignFrom_(const SnapshotDeque& other) {
+    if (allocator_ == other.allocator_) {
+      shareFrom_(other);
+      return;
+    }
+    for (const T& value : other) {
+      emplaceBack(value);
+    }
+  }
+
+  void swapContents_(SnapshotDeque& other) noexcept {
+    using std::swap;
+    swap(map_, other.map_);
+    swap(map_capacity_, other.map_capacity_);
+    swap(start_, other.start_);
+    swap(finish_, other.finish_);
+    swap(stats_, other.stats_);
+  }
+
+  void swapAllocators_(SnapshotDeque& other) noexcept {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+    swap(map_allocator_, other.map_allocator_);
+    swap(block_allocator_, other.block_allocator_);
+  }
+
+  T** map_ = nullptr;
+  size_type map_capacity_ = 0;
+  // 段空间中的绝对位置：块号 = pos / BlockSize，块内偏移 = pos % BlockSize。
+  size_type start_ = 0;
+  size_type finish_ = 0;
+  BlockStats stats_{};
+
+  element_allocator_type allocator_{};
+  map_allocator_type map_allocator_;
+  block_allocator_type block_allocator_;
+};
+
+template <class T, class Allocator, std::size_t BlockSize>
+inline void swap(SnapshotDeque<T, Allocator, BlockSize>& lhs, SnapshotDeque<T, Allocator, BlockSize>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace deque
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "deque/detail/concurrent.hpp"
+#include "deque/detail/memory.hpp"
+#include "deque/detail/storage.hpp"
+
+namespace deque {
+
+// Lock-free single-producer/single-consumer queue on the segmented block model.
+// One thread calls the tryPush* functions, one other thread calls the tryPop*
+// functions. Elements live in BlockSize-element blocks chained by an atomic
+// link; head_/tail_ are monotonically increasing element counters published
+// with release/acquire, each side caching the other's counter on its own cache line.
+//
+// Drained blocks are handed back to the producer through a lock-free stack, so
+// every block allocation and deallocation happens on the producer thread and
+// the allocator itself need not be thread-safe.
+template <class T, class Allocator = std::allocator<T>, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class SpscDeque {
+ public:
+  using value_type = T;
+  using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using size_type = std::size_t;
+
+  static constexpr size_type block_size = BlockSize;
+  static_assert(block_size > 0, "BlockSize must be positive");
+  static constexpr size_type unbounded = std::numeric_limits<size_type>::max();
+  static constexpr size_type default_spare_block_limit = 4;
+
+  SpscDeque() : SpscDeque(unbounded) {}
+
+  // capacity 限制同时在队列中的元素数；默认无上限，tryPush* 只在分配失败时抛出。
+  explicit SpscDeque(size_type capacity, const allocator_type& allocator = allocator_type())
+      : allocator_(allocator), node_allocator_(allocator_), capacity_(capacity) {
+    assert(capacity_ > 0);
+    Node* node = allocateNode_();
+    producer_.block = node;
+    consumer_.block = node;
+  }
+
+  SpscDeque(const SpscDeque&) = delete;
+  SpscDeque& operator=(const SpscDeque&) = delete;
+
+  ~SpscDeque() {
+    // 析构时两端线程都已停止，按顺序销毁剩余元素并释放所有块。
+    size_type remaining = producer_.tail.load(std::memory_order_relaxed) - consumer_.head.load(std::memory_order_relaxed);
+    Node* node = consumer_.block;
+    size_type offset = consumer_.offset;
+    while (remaining > 0) {
+      if (offset == block_size) {
+        node = node->next.load(std::memory_order_relaxed);
+        offset = 0;
+      }
+      size_type chunk = std::min(remaining, block_size - offset);
+      detail::destroyN(allocator_, node->data + offset, chunk);
+      offset += chunk;
+      remaining -= chunk;
+    }
+    freeChain_(consumer_.block);
+    freeChain_(producer_.spare);
+    freeChain_(recycled_.load(std::memory_order_acquire));
+  }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  // 作用：返回当前元素数的近似值；两端并发修改时只是某一时刻的快照。
+  size_type sizeApprox() const noexcept {
+    size_type head = consumer_.head.load(std::memory_order_acquire);
+    size_type tail = producer_.tail.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  bool emptyApprox() const noexcept { return sizeApprox() == 0; }
+
+  // ---- 生产者端 ----
+
+  bool tryPushBack(const T& value) { return tryEmplaceBack(value); }
+  bool tryPushBack(T&& value) { return tryEmplaceBack(std::move(value)); }
+
+  template <class... Args>
+  bool tryEmplaceBack(Args&&... args) {
+    size_type tail = producer_.tail.load(std::memory_order_relaxed);
+    if (freeSlots_(tail, 1) == 0) {
+      return false;
+    }
+    T* slot = producerSlot_();
+    detail::constructAt(allocator_, slot, std::forward<Args>(args)...);
+    ++producer_.offset;
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 作用：从 first 起最多推入 count 个元素，返回实际推入数；整批只发布一次 tail。
+  template <class ForwardIt>
+  size_type tryPushBulk(ForwardIt first, size_type count) {
+    size_type tail = producer_.tail.load(std::memory_order_relaxed);
+    size_type n = std::min(count, freeSlots_(tail, count));
+    size_type done = 0;
+    try {
+      while (done < n) {
+        T* slot = producerSlot_();
+        size_type chunk = std::min(n - done, block_size - producer_.offset);
+        first = detail::uninitializedCopyN(allocator_, first, chunk, slot);
+        producer_.offset += chunk;
+        done += chunk;
+      }
+    } catch (...) {
+      // 已完整构造的片段照常发布，失败的片段已由 uninitializedCopyN 回滚。
+      producer_.tail.store(tail + done, std::memory_order_release);
+      throw;
+    }
+    producer_.tail.store(tail + done, std::memory_order_release);
+    return done;
+  }
+
+  // ---- 消费者端 ----
+
+  bool tryPopFront(T& out) {
+    size_type head = consumer_.head.load(std::memory_order_relaxed);
+    if (readySlots_(head, 1) == 0) {
+      return false;
+    }
+    T* slot = consumerSlot_();
+    out = std::move(*slot);
+    detail::destroyAt(allocator_, slot);
+    ++consumer_.offset;
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 作用：最多弹出 max_count 个元素写入 out，返回实际弹出数；整批只发布一次 head。
+  template <class OutputIt>
+  size_type tryPopBulk(OutputIt out, size_type max_count) {
+    size_type done = 0;
+    return tryPopBulk(out, max_count, done);
+  }
+
+  // 作用：同上，已弹出的个数随时记在 done 中：写入 out 抛出异常时，已经取走的元素照常发布，
+  // 调用者仍能从 done 得知实际弹出数（例如据此维护外部的元素计数）。
+  template <class OutputIt>
+  size_type tryPopBulk(OutputIt out, size_type max_count, size_type& done) {
+    size_type head = consumer_.head.load(std::memory_order_relaxed);
+    size_type n = std::min(max_count, readySlots_(head, max_count));
+    done = 0;
+    try {
+      while (done < n) {
+        T* slot = consumerSlot_();
+        size_type chunk = std::min(n - done, block_size - consumer_.offset);
+        for (size_type i = 0; i < chunk; ++i) {
+          *out = std::move(slot[i]);
+          ++out;
+          detail::destroyAt(allocator_, slot + i);
+          ++consumer_.offset;
+          ++done;
+        }
+      }
+    } catch (...) {
+      consumer_.head.store(head + done, std::memory_order_release);
+      throw;
+    }
+    consumer_.head.store(head + done, std::memory_order_release);
+    return done;
+  }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    T* data = nullptr;
+  };
+
+  using node_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<Node>;
+  using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+  // 生产者独占的状态：tail 由消费者读取，其余字段只有生产者访问。
+  struct alignas(detail::cache_line_size) ProducerState {
+    std::atomic<size_type> tail{0};
+    Node* block = nullptr;
+    size_type offset = 0;
+    size_type cached_head = 0;
+    Node* spare = nullptr;
+    size_type spare_count = 0;
+  };
+
+  // 消费者独占的状态：head 由生产者读取，其余字段只有消费者访问。
+  struct alignas(detail::cache_line_size) ConsumerState {
+    std::atomic<size_type> head{0};
+    Node* block = nullptr;
+    size_type offset = 0;
+    size_type cached_tail = 0;
+  };
+
+  // 作用：返回生产者还能推入的元素数；缓存的 head 不足 wanted 时才重新读取。
+  size_type freeSlots_(size_type tail, size_type wanted) noexcept {
+    if (capacity_ == unbounded) {
+      return unbounded;
+    }
+    size_type free_slots = capacity_ - (tail - producer_.cached_head);
+    if (free_slots < wanted) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      free_slots = capacity_ - (tail - producer_.cached_head);
+    }
+    return free_slots;
+  }
+
+  // 作用：返回消费者可弹出的元素数；缓存的 tail 不足 wanted 时才重新读取。
+  size_type readySlots_(size_type head, size_type wanted) noexcept {
+    size_type ready = consumer_.cached_tail - head;
+    if (ready < wanted) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      ready = consumer_.cached_tail - head;
+    }
+    return ready;
+  }
+
+  // 作用：返回下一个待构造槽位；当前块写满时先链接一个新块。
+  // 新块的链接在发布 tail 之前完成，消费者看到新元素时一定能看到链接。
+  T* producerSlot_() {
+    if (producer_.offset == block_size) {
+      Node* node = acquireNode_();
+      producer_.block->next.store(node, std::memory_order_release);
+      producer_.block = node;
+      producer_.offset = 0;
+    }
+    return producer_.block->data + producer_.offset;
+  }
+
+  // 作用：返回下一个待弹出槽位；当前块读完时前进到下一块并把旧块交还生产者。
+  // 调用前已确认至少有一个可读元素，因此生产者已经离开旧块。
+  T* consumerSlot_() noexcept {
+    if (consumer_.offset == block_size) {
+      Node* drained = consumer_.block;
+      consumer_.block = drained->next.load(std::memory_order_acquire);
+      consumer_.offset = 0;
+      recycle_(drained);
+    }
+    return consumer_.block->data + consumer_.offset;
+  }
+
+  // 作用：消费者把腾空的块压入回收栈。生产者只会整体取走整个栈，不存在 ABA 问题。
+  void recycle_(Node* node) noexcept {
+    Node* top = recycled_.load(std::memory_order_relaxed);
+    do {
+      node->next.store(top, std::memory_order_relaxed);
+    } while (!recycled_.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  // 作用：生产者获取一个空块：先用本地缓存，再整体取走回收栈，最后才向分配器申请。
+  Node* acquireNode_() {
+    if (producer_.spare == nullptr) {
+      adoptRecycled_();
+    }
+    if (producer_.spare != nullptr) {
+      Node* node = producer_.spare;
+      producer_.spare = node->next.load(std::memory_order_relaxed);
+      --producer_.spare_count;
+      node->next.store(nullptr, std::memory_order_relaxed);
+      return node;
+    }
+    return allocateNode_();
+  }
+
+  // 作用：取走回收栈中的全部块，超出缓存上限的部分立即释放。
+  void adoptRecycled_() noexcept {
+    Node* node = recycled_.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      if (producer_.spare_count < default_spare_block_limit) {
+        node->next.store(producer_.spare, std::memory_order_relaxed);
+        producer_.spare = node;
+        ++producer_.spare_count;
+      } else {
+        deallocateNode_(node);
+      }
+      node = next;
+    }
+  }
+
+  Node* allocateNode_() {
+    Node* node = node_allocator_traits::allocate(node_allocator_, 1);
+    node_allocator_traits::construct(node_allocator_, node);
+    try {
+      node->data = detail::allocateBlock(allocator_, block_size);
+    } catch (...) {
+      node_allocator_traits::destroy(node_allocator_, node);
+      node_allocator_traits::deallocate(node_allocator_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void deallocateNode_(Node* node) noexcept {
+    detail::deallocateBlock(allocator_, node->data, block_size);
+    node_allocator_traits::destroy(node_allocator_, node);
+    node_allocator_traits::deallocate(node_allocator_, node, 1);
+  }
+
+  void freeChain_(Node* node) noexcept {
+    while (node != nullptr) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      deallocateNode_(node);
+      node = next;
+    }
+  }
+
+  ProducerState producer_;
+  ConsumerState consumer_;
+  alignas(detail::cache_line_size) std::atomic<Node*> recycled_{nullptr};
+  allocator_type allocator_;
+  node_allocator_type node_allocator_;
+  size_type capacity_;
+};
+
+}  // namespace deque
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "deque/detail/concurrent.hpp"
+#include "deque/detail/storage.hpp"
+
+namespace deque {
+
+// Chase–Lev work-stealing deque (Lê et al., "Correct and Efficient Work-Stealing
+// for Weak Memory Models"). The owning thread pushes and pops at the bottom;
+// any number of other threads steal from the top without locks.
+//
+// The circular buffer is segmented: a ring is a map of BlockSize-slot blocks.
+// Growing doubles the map and re-links the existing blocks into it instead of
+// copying every element; only a block whose live elements straddle both halves
+// of the new ring is copied (and the old one retired), so a thief still
+// reading through the previous ring never sees a slot reused.
+//
+// T must be trivially copyable (typically a task pointer or handle): slots are
+// std::atomic<T> because a thief may read a slot that the owner is racing on.
+template <class T, std::size_t BlockSize = detail::defaultBlockSize<T>()>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable T");
+  static_assert(detail::isPowerOfTwo(BlockSize), "BlockSize must be a power of two");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr size_type block_size = BlockSize;
+
+  // initial_capacity 会向上取整到 block_size 的 2 的幂倍。
+  explicit WorkStealingDeque(size_type initial_capacity = block_size) {
+    size_type capacity = block_size;
+    while (capacity < initial_capacity) {
+      capacity *= 2;
+    }
+    Ring* ring = newRing_(capacity);
+    for (auto& block : ring->blocks) {
+      block = newBlock_();
+    }
+    ring_.store(ring, std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // 作用：仅所有者线程调用；把 value 压入底部，环满时先扩容。
+  void push(const T& value) {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<std::int64_t>(ring->capacity) - 1) {
+      ring = grow_(ring, t, b);
+      ring_.store(ring, std::memory_order_release);
+    }
+    ring->slot(b).store(value, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  // 作用：仅所有者线程调用；从底部弹出，为空或最后一个元素被窃取时返回 nullopt。
+  std::optional<T> pop() {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    T value = ring->slot(b).load(std::memory_order_relaxed);
+    if (t == b) {
+      // 只剩最后一个元素时与窃取者竞争 top。
+      bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      if (!won) {
+        return std::nullopt;
+      }
+    }
+    return value;
+  }
+
+  // 作用：任意线程调用；从顶部窃取，为空或与其它线程竞争失败时返回 nullopt。
+  std::optional<T> steal() {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return std::nullopt;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    T value = ring->slot(t).load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  // 作用：返回元素数的近似值；并发修改时只是某一时刻的快照。
+  size_type sizeApprox() const noexcept {
+    std::int64_t b = bottom_.load(std::memory_order_acquire);
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+
+  bool emptyApprox() const noexcept { return sizeApprox() == 0; }
+
+  size_type capacity() const noexcept { return ring_.load(std::memory_order_relaxed)->capacity; }
+
+ private:
+  using Slot = std::atomic<T>;
+
+  struct Ring {
+    size_type capacity;
+    size_type mask;
+    std::vector<Slot*> blocks;
+
+    Slot& slot(std::int64_t index) const noexcept {
+      size_type position = static_cast<size_type>(index) & mask;
+      return blocks[position / block_size][position % block_size];
+    }
+  };
+
+  Ring* newRing_(size_type capacity) {
+    auto ring = std::make_unique<Ring>();
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    ring->blocks.assign(capacity / block_size, nullptr);
+    rings_.push_back(std::move(ring));
+    return rings_.back().get();
+  }
+
+  Slot* newBlock_() {
+    blocks_.push_back(std::make_unique<Slot[]>(block_size));
+    return blocks_.back().get();
+  }
+
+  // 作用：仅所有者线程调用；把容量翻倍。旧环与旧块保留到析构，窃取者可能仍在读取。
+  // 新环的第 j 块只接收旧环第 j % old_blocks 块中的元素，所以旧块要么整体挂到
+  // 新环的某一半，要么（活跃元素跨越两半时）被复制后退役，不会再被写入。
+  Ring* grow_(Ring* old_ring, std::int64_t t, std::int64_t b) {
+    const size_type old_blocks = old_ring->blocks.size();
+    Ring* ring = newRing_(old_ring->capacity * 2);
+
+    constexpr size_type unassigned = static_cast<size_type>(-1);
+    std::vector<size_type> target(old_blocks, unassigned);
+    std::vector<bool> straddles(old_blocks, false);
+    forEachChunk_(ring, old_ring, t, b, [&](std::int64_t, std::int64_t, size_type old_block, size_type new_block) {
+      if (target[old_block] == unassigned) {
+        target[old_block] = new_block;
+      } else if (target[old_block] != new_block) {
+        straddles[old_block] = true;
+      }
+    });
+
+    for (size_type k = 0; k < old_blocks; ++k) {
+      if (!straddles[k]) {
+        ring->blocks[target[k] == unassigned ? k : target[k]] = old_ring->blocks[k];
+      }
+    }
+    for (auto& block : ring->blocks) {
+      if (block == nullptr) {
+        block = newBlock_();
+      }
+    }
+    forEachChunk_(ring, old_ring, t, b, [&](std::int64_t first, std::int64_t last, size_type old_block, size_type) {
+      if (straddles[old_block]) {
+        for (std::int64_t i = first; i < last; ++i) {
+          ring->slot(i).store(old_ring->slot(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+      }
+    });
+    return ring;
+  }
+
+  // 作用：把 [t, b) 按块边界切成片段，对每段调用 fn(first, last, 旧块号, 新块号)。
+  template <class Fn>
+  static void forEachChunk_(const Ring* ring, const Ring* old_ring, std::int64_t t, std::int64_t b, Fn&& fn) {
+    constexpr auto block = static_cast<std::int64_t>(block_size);
+    while (t < b) {
+      std::int64_t chunk_end = std::min(b, (t / block + 1) * block);
+      size_type old_block = (static_cast<size_type>(t) & old_ring->mask) / block_size;
+      size_type new_block = (static_cast<size_type>(t) & ring->mask) / block_size;
+      fn(t, chunk_end, old_block, new_block);
+      t = chunk_end;
+    }
+  }
+
+  alignas(detail::cache_line_size) std::atomic<std::int64_t> top_{0};
+  alignas(detail::cache_line_size) std::atomic<std::int64_t> bottom_{0};
+  alignas(detail::cache_line_size) std::atomic<Ring*> ring_{nullptr};
+  // 以下只由所有者线程访问：全部环与块的所有权，析构时统一释放。
+  std::vector<std::unique_ptr<Ring>> rings_;
+  std::vector<std::unique_ptr<Slot[]>> blocks_;
+};
+
+}  // namespace deque
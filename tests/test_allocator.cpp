@@ -0,0 +1,157 @@
+//验证分配器支持（映射数组使用同一分配器、传播特性、pmr 别名）
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+// 记录分配次数的内存资源，转发给上游资源
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream) {}
+
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes_in_use = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    bytes_in_use += bytes;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+    ++deallocations;
+    bytes_in_use -= bytes;
+    upstream_->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  std::pmr::memory_resource* upstream_;
+};
+
+// 带状态的分配器，三种传播特性都为真
+template <class T>
+struct PropagatingAllocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  int id = 0;
+
+  PropagatingAllocator() = default;
+  explicit PropagatingAllocator(int allocator_id) : id(allocator_id) {}
+  template <class U>
+  PropagatingAllocator(const PropagatingAllocator<U>& other) : id(other.id) {}
+
+  T* allocate(std::size_t count) { return std::allocator<T>().allocate(count); }
+  void deallocate(T* ptr, std::size_t count) { std::allocator<T>().deallocate(ptr, count); }
+
+  template <class U>
+  bool operator==(const PropagatingAllocator<U>& other) const { return id == other.id; }
+  template <class U>
+  bool operator!=(const PropagatingAllocator<U>& other) const { return id != other.id; }
+};
+
+}  // namespace
+
+static void testEverythingComesFromTheResource() {
+  CountingResource resource;
+  // 默认资源设为 null：任何绕过 resource 的分配都会抛异常
+  std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+  {
+    deque::pmr::Deque<int> d(&resource);
+    for (int i = 0; i < 10000; ++i) {
+      d.pushBack(i);
+      d.pushFront(-i);
+    }
+    assert(resource.allocations > 0);
+    assert(d.getAllocator().resource() == &resource);
+
+    deque::pmr::Deque<int> copy(d, &resource);
+    assert(copy == d);
+  }
+  std::pmr::set_default_resource(previous);
+  assert(resource.bytes_in_use == 0);
+  assert(resource.allocations == resource.deallocations);
+}
+
+static void testPmrAssignmentKeepsResource() {
+  CountingResource first;
+  CountingResource second;
+
+  deque::pmr::Deque<std::string> a(&first);
+  deque::pmr::Deque<std::string> b(&second);
+  for (int i = 0; i < 500; ++i) {
+    a.pushBack(std::to_string(i));
+  }
+
+  // polymorphic_allocator 不传播：赋值后 b 仍使用 second
+  b = a;
+  assert(b == a);
+  assert(b.getAllocator().resource() == &second);
+
+  deque::pmr::Deque<std::string> c(&second);
+  c = std::move(a);
+  assert(c.getAllocator().resource() == &second);
+  assert(c.size() == 500 && c[499] == "499");
+
+  // 资源相等时移动构造直接接管块
+  std::size_t before = second.allocations;
+  deque::pmr::Deque<std::string> d(std::move(c), &second);
+  assert(d.size() == 500);
+  assert(second.allocations - before <= 2);
+
+  // 资源相等的两个容器可以交换
+  d.swap(b);
+  assert(d.size() == 500 && b.size() == 500);
+}
+
+static void testMonotonicArena() {
+  std::vector<std::byte> buffer(1 << 20);
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  deque::pmr::Deque<double> d(&arena);
+  for (int i = 0; i < 20000; ++i) {
+    d.pushBack(i * 0.5);
+  }
+  assert(d.size() == 20000 && d.back() == 19999 * 0.5);
+}
+
+static void testPropagatingAllocator() {
+  using Alloc = PropagatingAllocator<int>;
+  deque::Deque<int, Alloc> a{Alloc(1)};
+  deque::Deque<int, Alloc> b{Alloc(2)};
+  for (int i = 0; i < 300; ++i) {
+    a.pushBack(i);
+  }
+
+  b = a;
+  assert(b.getAllocator().id == 1);
+  assert(b == a);
+
+  deque::Deque<int, Alloc> c{Alloc(3)};
+  c = std::move(a);
+  assert(c.getAllocator().id == 1);
+  assert(c.size() == 300);
+
+  deque::Deque<int, Alloc> d{Alloc(4)};
+  d.pushBack(7);
+  d.swap(c);
+  assert(d.getAllocator().id == 1 && d.size() == 300);
+  assert(c.getAllocator().id == 4 && c.size() == 1);
+}
+
+void runAllocatorTests() {
+  testEverythingComesFromTheResource();
+  testPmrAssignmentKeepsResource();
+  testMonotonicArena();
+  testPropagatingAllocator();
+}
@@ -0,0 +1,124 @@
+//验证批量接口（区间插入、append/prepend、批量填充）
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "deque/deque.hpp"
+
+template <class MyDeque, class T>
+static void assertSame(const MyDeque& my_deque, const std::deque<T>& std_deque) {
+  assert(my_deque.size() == std_deque.size());
+  for (std::size_t i = 0; i < my_deque.size(); ++i) {
+    assert(my_deque[i] == std_deque[i]);
+  }
+}
+
+static std::vector<int> makeRange(int first, int count) {
+  std::vector<int> values;
+  for (int i = 0; i < count; ++i) {
+    values.push_back(first + i);
+  }
+  return values;
+}
+
+static void testAppendPrepend() {
+  deque::Deque<int> d;
+  std::deque<int> expected;
+
+  auto a = makeRange(0, 1000);
+  d.append(a.begin(), a.end());
+  expected.insert(expected.end(), a.begin(), a.end());
+  assertSame(d, expected);
+
+  auto b = makeRange(-300, 300);
+  d.prepend(b.begin(), b.end());
+  expected.insert(expected.begin(), b.begin(), b.end());
+  assertSame(d, expected);
+
+  // 非随机访问的前向区间
+  std::list<int> c = {7, 8, 9};
+  d.prepend(c.begin(), c.end());
+  d.append(c.begin(), c.end());
+  expected.insert(expected.begin(), c.begin(), c.end());
+  expected.insert(expected.end(), c.begin(), c.end());
+  assertSame(d, expected);
+
+  // 单趟输入区间
+  std::istringstream in_front("1 2 3 4");
+  d.prepend(std::istream_iterator<int>(in_front), std::istream_iterator<int>());
+  expected.insert(expected.begin(), {1, 2, 3, 4});
+  std::istringstream in_back("5 6");
+  d.append(std::istream_iterator<int>(in_back), std::istream_iterator<int>());
+  expected.insert(expected.end(), {5, 6});
+  assertSame(d, expected);
+}
+
+template <class MyDeque>
+static void testInsertRangeAtEveryRegion() {
+  const std::size_t base_sizes[] = {0, 1, 10, 200};
+  const int counts[] = {0, 1, 5, 64, 150};
+  for (std::size_t base : base_sizes) {
+    for (int count : counts) {
+      for (std::size_t pos = 0; pos <= base; pos += (base / 7) + 1) {
+        MyDeque d;
+        std::deque<std::string> expected;
+        for (std::size_t i = 0; i < base; ++i) {
+          d.pushBack(std::to_string(i));
+          expected.push_back(std::to_string(i));
+        }
+        std::vector<std::string> values;
+        for (int i = 0; i < count; ++i) {
+          values.push_back("v" + std::to_string(i));
+        }
+        auto it = d.insert(d.begin() + static_cast<std::ptrdiff_t>(pos), values.begin(), values.end());
+        // libstdc++ 的 std::deque 在中间插入空区间时会自我移动赋值，跳过这种情况
+        if (count > 0) {
+          expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), values.begin(), values.end());
+        }
+        assert(it.getIndex() == pos);
+        assertSame(d, expected);
+
+        it = d.insert(d.begin() + static_cast<std::ptrdiff_t>(pos), static_cast<std::size_t>(count), "f");
+        if (count > 0) {
+          expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), static_cast<std::size_t>(count), "f");
+        }
+        assert(it.getIndex() == pos);
+        assertSame(d, expected);
+      }
+    }
+  }
+}
+
+static void testBulkFillAndAssign() {
+  deque::Deque<int> d;
+  d.resize(1000);
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i] == 0);
+  }
+  d.assign(700, 3);
+  assert(d.size() == 700 && d.front() == 3 && d.back() == 3);
+
+  // 用容器自身的元素作为填充值
+  d[0] = 11;
+  d.insert(d.begin() + 350, 100, d[0]);
+  assert(d.size() == 800 && d[350] == 11 && d[449] == 11 && d[450] == 3);
+  d.assign(10, d[0]);
+  assert(d.size() == 10 && d.back() == 11);
+
+  std::vector<int> values = makeRange(0, 5000);
+  d.assign(values.begin(), values.end());
+  assert(d.size() == 5000 && d[4999] == 4999);
+}
+
+void runBulkTests() {
+  testAppendPrepend();
+  testInsertRangeAtEveryRegion<deque::Deque<std::string>>();
+  testInsertRangeAtEveryRegion<deque::Deque<std::string, std::allocator<std::string>, 16>>();
+  testBulkFillAndAssign();
+}
@@ -0,0 +1,187 @@
+//验证多生产者多消费者阻塞队列 ConcurrentDeque
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "deque/concurrent_deque.hpp"
+
+using namespace std::chrono_literals;
+
+static void testSingleThreaded() {
+  deque::ConcurrentDeque<std::string, std::allocator<std::string>, 4> q(10);
+  assert(q.capacity() == 10);
+  std::string out;
+  assert(!q.tryPopFront(out));
+  assert(!q.popFrontFor(out, 1ms));
+
+  for (int i = 0; i < 10; ++i) {
+    assert(q.tryPushBack(std::to_string(i)));
+  }
+  assert(!q.tryPushBack("full"));
+  assert(!q.pushBackFor(std::string("full"), 1ms));
+  assert(q.sizeApprox() == 10);
+
+  assert(q.popFront(out) && out == "0");
+  std::vector<std::string> batch(8);
+  assert(q.popBulk(batch.begin(), 4) == 4);
+  assert(batch[0] == "1" && batch[3] == "4");
+  assert(q.tryPopBulk(batch.begin(), batch.size()) == 5);
+  assert(batch[0] == "5" && batch[4] == "9");
+  assert(q.emptyApprox());
+}
+
+static void testClose() {
+  deque::ConcurrentDeque<int> q;
+  q.pushBack(1);
+  q.pushBack(2);
+
+  std::thread waiter([&q] {
+    int value = 0;
+    assert(q.popFront(value) && value == 1);
+    assert(q.popFront(value) && value == 2);
+    // 队列已空，阻塞直到 close() 唤醒并返回 false。
+    assert(!q.popFront(value));
+  });
+  std::this_thread::sleep_for(5ms);
+  q.close();
+  waiter.join();
+
+  assert(q.closed());
+  assert(!q.pushBack(3));
+  int value = 0;
+  assert(q.popBulk(&value, 1) == 0);
+}
+
+static void testBlockingCapacity() {
+  deque::ConcurrentDeque<int> q(2);
+  q.pushBack(0);
+  q.pushBack(1);
+  std::atomic<bool> pushed{false};
+  std::thread producer([&] {
+    q.pushBack(2);  // 阻塞到消费者腾出空位
+    pushed.store(true);
+  });
+  std::this_thread::sleep_for(5ms);
+  assert(!pushed.load());
+  int value = -1;
+  assert(q.popFront(value) && value == 0);
+  producer.join();
+  assert(pushed.load());
+  assert(q.popFront(value) && value == 1);
+  assert(q.popFront(value) && value == 2);
+}
+
+static void testManyProducersConsumers() {
+  constexpr int producer_count = 4;
+  constexpr int consumer_count = 4;
+  constexpr int per_producer = 20000;
+  deque::ConcurrentDeque<int, std::allocator<int>, 16> q(64);
+
+  std::vector<std::atomic<int>> seen(producer_count * per_producer);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producer_count; ++p) {
+    threads.emplace_back([&q, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        bool ok = q.pushBack(p * per_producer + i);
+        assert(ok);
+        (void)ok;
+      }
+    });
+  }
+  std::vector<std::thread> consumers;
+  for (int c = 0; c < consumer_count; ++c) {
+    consumers.emplace_back([&q, &seen, c] {
+      std::vector<int> batch(8);
+      int last_seen[producer_count] = {-1, -1, -1, -1};
+      for (;;) {
+        std::size_t n = c % 2 == 0 ? q.popBulk(batch.begin(), batch.size()) : q.popFront(batch[0]) ? 1 : 0;
+        if (n == 0) {
+          return;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+          int value = batch[k];
+          // 同一生产者的元素在每个消费者看来保持先后顺序。
+          assert(value % per_producer > last_seen[value / per_producer]);
+          last_seen[value / per_producer] = value % per_producer;
+          seen[static_cast<std::size_t>(value)].fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  q.close();
+  for (auto& thread : consumers) {
+    thread.join();
+  }
+  for (auto& count : seen) {
+    assert(count.load() == 1);
+  }
+}
+
+// 写入 limit 个元素后，下一次赋值抛出异常
+struct ThrowingOutput {
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  std::vector<int>* sink;
+  std::size_t limit;
+
+  ThrowingOutput& operator*() { return *this; }
+  ThrowingOutput& operator++() { return *this; }
+  ThrowingOutput& operator=(int value) {
+    if (sink->size() == limit) {
+      throw std::runtime_error("output full");
+    }
+    sink->push_back(value);
+    return *this;
+  }
+};
+
+// 写入 out 中途抛出异常时，已取走的元素从计数中扣除，没取走的元素留在队列中
+static void testPopBulkThrowingOutput() {
+  deque::ConcurrentDeque<int, std::allocator<int>, 4> q(10);
+  for (int i = 0; i < 10; ++i) {
+    assert(q.tryPushBack(i));
+  }
+  std::vector<int> sink;
+  bool threw = false;
+  try {
+    q.popBulk(ThrowingOutput{&sink, 3}, 8);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw && sink.size() == 3);
+  assert(q.sizeApprox() == 7);
+
+  // 计数与队列内容一致：正好腾出 3 个空位，剩余元素按顺序取出
+  for (int i = 10; i < 13; ++i) {
+    assert(q.tryPushBack(i));
+  }
+  assert(!q.tryPushBack(13));
+  std::vector<int> rest(10);
+  assert(q.tryPopBulk(rest.begin(), rest.size()) == 10);
+  for (int i = 0; i < 10; ++i) {
+    assert(rest[static_cast<std::size_t>(i)] == i + 3);
+  }
+  int out = 0;
+  assert(q.emptyApprox() && !q.tryPopFront(out));
+}
+
+void runConcurrentTests() {
+  testSingleThreaded();
+  testClose();
+  testBlockingCapacity();
+  testManyProducersConsumers();
+  testPopBulkThrowingOutput();
+}
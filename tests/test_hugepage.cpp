@@ -0,0 +1,159 @@
+//验证大页分配器 HugePageAllocator（区域切块、腾空释放、独立映射、与 Deque 配合）
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "deque/hugepage_allocator.hpp"
+
+namespace {
+
+constexpr std::size_t kRegionBytes = deque::huge_page_bytes;
+
+template <class T>
+struct ConstructingAllocator {
+  using value_type = T;
+  ConstructingAllocator() = default;
+  template <class U>
+  ConstructingAllocator(const ConstructingAllocator<U>&) {}
+  T* allocate(std::size_t count) { return std::allocator<T>().allocate(count); }
+  void deallocate(T* ptr, std::size_t count) { std::allocator<T>().deallocate(ptr, count); }
+  template <class U, class... Args>
+  void construct(U* ptr, Args&&... args) {
+    ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace
+
+static void testAllocatorTraits() {
+  // 没有 construct/destroy 成员的分配器走批量构造与 memcpy 快速路径，自带 construct 的不走。
+  static_assert(deque::detail::uses_default_construct_v<deque::HugePageAllocator<int>, int>, "");
+  static_assert(deque::detail::is_bitwise_copyable_v<deque::HugePageAllocator<int>, int>, "");
+  static_assert(!deque::detail::uses_default_construct_v<ConstructingAllocator<int>, int>, "");
+
+  deque::HugePageAllocator<int> a(kRegionBytes);
+  deque::HugePageAllocator<double> rebound(a);
+  deque::HugePageAllocator<int> copy(rebound);
+  deque::HugePageAllocator<int> moved(std::move(copy));
+  assert(a == rebound && a == copy && a == moved);
+  assert(a != deque::HugePageAllocator<int>(kRegionBytes));
+  static_assert(deque::hugePageBlockSize<int>() * sizeof(int) == deque::huge_page_bytes, "");
+}
+
+static void testRoutingBySize() {
+  deque::HugePageAllocator<char> a(kRegionBytes);
+
+  // 小请求不占用区域
+  char* small = a.allocate(100);
+  assert(a.stats().regions_mapped == 0);
+  a.deallocate(small, 100);
+
+  // 中等请求从同一个区域切块
+  const std::size_t chunk = 64 * 1024;
+  char* first = a.allocate(chunk);
+  char* second = a.allocate(chunk);
+  auto stats = a.stats();
+  assert(stats.regions_mapped == 1 && stats.chunks_in_use == 2);
+  assert(reinterpret_cast<std::uintptr_t>(first) % 64 == 0);
+  first[0] = 1;
+  second[chunk - 1] = 2;
+  a.deallocate(first, chunk);
+  char* reused = a.allocate(chunk);
+  assert(reused == first);
+  a.deallocate(reused, chunk);
+  a.deallocate(second, chunk);
+  stats = a.stats();
+  assert(stats.chunks_in_use == 0);
+  assert(stats.regions_retained == 1);
+
+  // 超过四分之一区域的请求单独映射，归还时立即解除映射
+  const std::size_t big = kRegionBytes;
+  char* huge = a.allocate(big);
+  huge[0] = 1;
+  huge[big - 1] = 1;
+  assert(a.stats().dedicated_mappings == 1);
+  a.deallocate(huge, big);
+  assert(a.stats().dedicated_mappings == 0);
+  assert(a.stats().bytes_mapped == kRegionBytes);
+}
+
+static void testRegionsReleasedWhenDrained() {
+  // 4 KiB 块、2 MiB 区域：每个区域 512 块
+  using D = deque::Deque<int, deque::HugePageAllocator<int>, 1024>;
+  deque::HugePageAllocator<int> allocator(kRegionBytes, 1);
+  {
+    D d(allocator);
+    const std::size_t count = 1024 * 2000;
+    for (std::size_t i = 0; i < count; ++i) {
+      d.pushBack(static_cast<int>(i));
+    }
+    auto stats = allocator.stats();
+    assert(stats.regions_mapped >= 4);
+    assert(stats.chunks_in_use >= count / 1024);
+    for (std::size_t i = 0; i < count; i += 4097) {
+      assert(d[i] == static_cast<int>(i));
+    }
+    while (d.size() > 1) {
+      d.popFront();
+    }
+    d.shrinkToFit();
+    stats = allocator.stats();
+    assert(stats.regions_unmapped >= 2);
+    assert(stats.regions_retained <= 1);
+    assert(stats.chunks_in_use <= 2);
+  }
+  auto stats = allocator.stats();
+  assert(stats.chunks_in_use == 0);
+  assert(stats.bytes_mapped <= kRegionBytes);
+}
+
+static void testHugePageDequeMatchesStdDeque() {
+  deque::HugePageDeque<std::string> d;
+  std::deque<std::string> expected;
+  std::mt19937 rng(20);
+  for (int step = 0; step < 20000; ++step) {
+    auto op = rng() % 6;
+    std::string value(1 + rng() % 40, static_cast<char>('a' + step % 26));
+    if (op < 2) {
+      d.pushBack(value);
+      expected.push_back(value);
+    } else if (op < 4) {
+      d.pushFront(value);
+      expected.push_front(value);
+    } else if (!expected.empty()) {
+      if (op == 4) {
+        d.popBack();
+        expected.pop_back();
+      } else {
+        d.popFront();
+        expected.pop_front();
+      }
+    }
+  }
+  assert(d.size() == expected.size());
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i] == expected[i]);
+  }
+
+  // 分配器随移动、交换一起传播；拷贝共享同一个 arena
+  deque::HugePageDeque<std::string> copy(d);
+  assert(copy.getAllocator() == d.getAllocator());
+  deque::HugePageDeque<std::string> other;
+  other.swap(copy);
+  assert(other == d && copy.empty());
+  deque::HugePageDeque<std::string> moved(std::move(other));
+  assert(moved == d);
+}
+
+void runHugePageTests() {
+  testAllocatorTraits();
+  testRoutingBySize();
+  testRegionsReleasedWhenDrained();
+  testHugePageDequeMatchesStdDeque();
+}
@@ -1,6 +1,8 @@
 //验证迭代器体系（随机访问迭代器、反向迭代器）
+#include <algorithm>
 #include <cassert>
 #include <numeric>
+#include <random>
 #include <vector>
 
 #include "deque/deque.hpp"
@@ -41,4 +43,39 @@ void runIteratorTests() {
   // 常量迭代器
   deque::Deque<int>::const_iterator cit = d.begin();
   assert(*cit == 0);
+
+  // 跨块移动：前端插入使起点落在块中间
+  deque::Deque<int> mixed;
+  for (int i = 0; i < 500; ++i) {
+    mixed.pushFront(-1 - i);
+    mixed.pushBack(i);
+  }
+  for (std::ptrdiff_t n = 0; n <= static_cast<std::ptrdiff_t>(mixed.size()); n += 37) {
+    auto pos = mixed.begin() + n;
+    assert(pos - mixed.begin() == n);
+    assert(pos.getIndex() == static_cast<std::size_t>(n));
+    assert(mixed.end() - pos == static_cast<std::ptrdiff_t>(mixed.size()) - n);
+    if (n < static_cast<std::ptrdiff_t>(mixed.size())) {
+      assert(*pos == mixed[static_cast<std::size_t>(n)]);
+    }
+  }
+  auto back_it = mixed.end();
+  for (std::size_t i = mixed.size(); i > 0; --i) {
+    --back_it;
+    assert(*back_it == mixed[i - 1]);
+  }
+  assert(back_it == mixed.begin());
+  assert(mixed.begin() < mixed.end() && mixed.end() > mixed.begin() + 999);
+
+  // 标准算法
+  std::mt19937 rng(7);
+  deque::Deque<int> shuffled;
+  for (int i = 0; i < 5000; ++i) {
+    shuffled.pushBack(static_cast<int>(rng() % 10000));
+  }
+  std::sort(shuffled.begin(), shuffled.end());
+  assert(std::is_sorted(shuffled.begin(), shuffled.end()));
+  auto found = std::lower_bound(shuffled.begin(), shuffled.end(), 5000);
+  assert(found == shuffled.end() || *found >= 5000);
+  assert(found == shuffled.begin() || *(found - 1) < 5000);
 }
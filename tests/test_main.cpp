@@ -7,6 +7,20 @@ void runIteratorTests();
 void runModifierTests();
 void runCompareTests();
 void runVsStdDequeTests();
+void runMemoryTests();
+void runBulkTests();
+void runAllocatorTests();
+void runSegmentTests();
+void runSpscTests();
+void runWorkStealingTests();
+void runConcurrentTests();
+void runRingTests();
+void runSmallTests();
+void runHugePageTests();
+void runMappedTests();
+void runParallelTests();
+void runSpliceTests();
+void runSnapshotTests();
 
 int main() {
   try {
@@ -15,6 +29,20 @@ int main() {
     runModifierTests();
     runCompareTests();
     runVsStdDequeTests();
+    runMemoryTests();
+    runBulkTests();
+    runAllocatorTests();
+    runSegmentTests();
+    runSpscTests();
+    runWorkStealingTests();
+    runConcurrentTests();
+    runRingTests();
+    runSmallTests();
+    runHugePageTests();
+    runMappedTests();
+    runParallelTests();
+    runSpliceTests();
+    runSnapshotTests();
   } catch (const std::exception& ex) {
     std::cerr << "Test failed with exception: " << ex.what() << "\n";
     return 1;
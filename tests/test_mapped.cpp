@@ -0,0 +1,348 @@
+//验证文件映射的持久化双端队列 MappedDeque（重新打开、空间复用、文件校验、进程崩溃后的一致性）
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "deque/mapped_deque.hpp"
+
+namespace {
+
+using Mapped = deque::MappedDeque<std::uint64_t, 16>;
+
+std::string tempPath(const char* name) {
+  const char* dir = std::getenv("TMPDIR");
+  return std::string(dir != nullptr ? dir : "/tmp") + "/deque_" + name + "_" + std::to_string(::getpid()) + ".map";
+}
+
+template <class Container>
+bool sameContents(const Container& c, const std::deque<std::uint64_t>& ref) {
+  if (c.size() != ref.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < ref.size(); ++i) {
+    if (c[i] != ref[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void pushBack(Mapped& c, std::uint64_t v) { c.pushBack(v); }
+void pushBack(std::deque<std::uint64_t>& c, std::uint64_t v) { c.push_back(v); }
+void pushFront(Mapped& c, std::uint64_t v) { c.pushFront(v); }
+void pushFront(std::deque<std::uint64_t>& c, std::uint64_t v) { c.push_front(v); }
+void popBack(Mapped& c) { c.popBack(); }
+void popBack(std::deque<std::uint64_t>& c) { c.pop_back(); }
+void popFront(Mapped& c) { c.popFront(); }
+void popFront(std::deque<std::uint64_t>& c) { c.pop_front(); }
+
+// 第 step 步操作：由 (seed, step) 决定，崩溃测试的父子进程各自重放同一序列。
+template <class Container>
+void applyStep(Container& c, std::uint64_t seed, std::uint64_t step) {
+  // splitmix64
+  std::uint64_t mixed = seed + step * 0x9e3779b97f4a7c15ULL;
+  mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+  const auto roll = (mixed ^ (mixed >> 31)) % 1000;
+  if (roll == 0) {
+    c.clear();
+  } else if (c.empty() || roll < 380) {
+    pushBack(c, step);
+  } else if (roll < 620) {
+    pushFront(c, step);
+  } else if (roll < 810) {
+    popBack(c);
+  } else {
+    popFront(c);
+  }
+}
+
+}  // namespace
+
+static void testReopenKeepsContents() {
+  const std::string path = tempPath("reopen");
+  std::remove(path.c_str());
+  std::deque<std::uint64_t> ref;
+  {
+    Mapped c(path);
+    assert(c.empty());
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+      if (i % 3 == 0) {
+        c.pushFront(i);
+        ref.push_front(i);
+      } else {
+        c.pushBack(i);
+        ref.push_back(i);
+      }
+    }
+    for (int i = 0; i < 100; ++i) {
+      c.popFront();
+      ref.pop_front();
+      c.popBack();
+      ref.pop_back();
+    }
+    assert(sameContents(c, ref));
+  }
+  {
+    Mapped c(path);
+    assert(sameContents(c, ref));
+    assert(c.front() == ref.front() && c.back() == ref.back());
+
+    std::uint64_t sum = 0;
+    for (std::uint64_t value : c) {
+      sum += value;
+    }
+    std::uint64_t ref_sum = 0;
+    for (std::uint64_t value : ref) {
+      ref_sum += value;
+    }
+    assert(sum == ref_sum);
+
+    // 重新打开后继续修改，再打开一次
+    c.pushBack(7);
+    ref.push_back(7);
+    c[0] = 42;
+    ref[0] = 42;
+    c.sync();
+    c.sync(deque::SyncMode::async);
+  }
+  {
+    Mapped c(path);
+    assert(sameContents(c, ref));
+    c.clear();
+    assert(c.empty());
+  }
+  {
+    Mapped c(path);
+    assert(c.empty());
+  }
+  std::remove(path.c_str());
+}
+
+static void testReferencesSurviveGrowth() {
+  const std::string path = tempPath("stable");
+  std::remove(path.c_str());
+  {
+    Mapped c(path);
+    c.pushBack(1);
+    const std::uint64_t* first = &c.front();
+    const std::size_t initial_bytes = c.fileBytes();
+    // 足够多的元素迫使文件与映射数组多次增长
+    for (std::uint64_t i = 0; i < 200000; ++i) {
+      c.pushBack(c.front() + i);
+    }
+    assert(c.fileBytes() > initial_bytes);
+    assert(&c.front() == first && *first == 1);
+    assert(c.back() == 1 + 199999);
+  }
+  std::remove(path.c_str());
+}
+
+static void testSteadyStateDoesNotGrowFile() {
+  const std::string path = tempPath("fifo");
+  std::remove(path.c_str());
+  {
+    Mapped c(path);
+    for (std::uint64_t i = 0; i < 500; ++i) {
+      c.pushBack(i);
+    }
+    // 预热：让映射数组与空闲栈到达稳态
+    for (std::uint64_t i = 500; i < 20000; ++i) {
+      c.pushBack(i);
+      c.popFront();
+    }
+    const std::size_t bytes = c.fileBytes();
+    for (std::uint64_t i = 20000; i < 200000; ++i) {
+      c.pushBack(i);
+      c.popFront();
+    }
+    assert(c.fileBytes() == bytes);
+    assert(c.size() == 500 && c.front() == 199500 && c.back() == 199999);
+
+    // 反方向的 FIFO 复用同一批块
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+      c.pushFront(i);
+      c.popBack();
+    }
+    assert(c.fileBytes() == bytes);
+  }
+  std::remove(path.c_str());
+}
+
+static void testRejectsMismatchedFiles() {
+  const std::string path = tempPath("mismatch");
+  std::remove(path.c_str());
+  {
+    Mapped c(path);
+    c.pushBack(1);
+
+    // 同一文件只能被打开一次
+    bool locked = false;
+    try {
+      Mapped again(path);
+    } catch (const std::system_error&) {
+      locked = true;
+    }
+    assert(locked);
+  }
+
+  bool wrong_type = false;
+  try {
+    deque::MappedDeque<std::uint32_t, 16> c(path);
+  } catch (const std::runtime_error&) {
+    wrong_type = true;
+  }
+  assert(wrong_type);
+
+  bool wrong_block = false;
+  try {
+    deque::MappedDeque<std::uint64_t, 32> c(path);
+  } catch (const std::runtime_error&) {
+    wrong_block = true;
+  }
+  assert(wrong_block);
+
+  // 不是 MappedDeque 的文件
+  const std::string junk = tempPath("junk");
+  {
+    std::FILE* file = std::fopen(junk.c_str(), "wb");
+    std::string bytes(deque::detail::mapped_file_granule, 'x');
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+  }
+  bool not_mapped = false;
+  try {
+    Mapped c(junk);
+  } catch (const std::runtime_error&) {
+    not_mapped = true;
+  }
+  assert(not_mapped);
+
+  // 打开失败不影响原文件
+  {
+    Mapped c(path);
+    assert(c.size() == 1 && c.front() == 1);
+  }
+  std::remove(path.c_str());
+  std::remove(junk.c_str());
+}
+
+static void testMoveAndSwap() {
+  const std::string path_a = tempPath("move_a");
+  const std::string path_b = tempPath("move_b");
+  std::remove(path_a.c_str());
+  std::remove(path_b.c_str());
+  {
+    Mapped a(path_a);
+    Mapped b(path_b);
+    a.pushBack(1);
+    b.pushBack(2);
+    b.pushBack(3);
+    swap(a, b);
+    assert(a.size() == 2 && a.path() == path_b);
+    assert(b.size() == 1 && b.path() == path_a);
+
+    Mapped moved(std::move(a));
+    assert(moved.size() == 2 && moved.back() == 3);
+    // 被移走的对象不持有文件，只读为空，仍可清空、遍历并重新接受赋值
+    assert(a.empty() && a.size() == 0);
+    assert(a.begin() == a.end());
+    a.clear();
+    a = std::move(moved);
+    assert(a.size() == 2);
+    assert(moved.empty());
+    moved = std::move(b);
+    assert(moved.size() == 1 && moved.front() == 1);
+    assert(b.size() == 0);
+  }
+  std::remove(path_a.c_str());
+  std::remove(path_b.c_str());
+}
+
+// 子进程按确定的序列操作文件，父进程在随机时刻 SIGKILL；重新打开后的内容
+// 必须等于某个操作前缀的结果：已完成的 k 步或正在进行的第 k+1 步。
+static void testCrashConsistency() {
+  const std::string path = tempPath("crash");
+  constexpr std::uint64_t max_steps = 2000000;
+
+  // 子进程每完成一步就更新的共享计数
+  void* shared = ::mmap(nullptr, sizeof(std::uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  assert(shared != MAP_FAILED);
+  auto* progress = static_cast<volatile std::uint64_t*>(shared);
+
+  std::mt19937_64 rng(2024);
+  for (int round = 0; round < 12; ++round) {
+    std::remove(path.c_str());
+    const std::uint64_t seed = rng();
+    *progress = 0;
+
+    pid_t child = ::fork();
+    assert(child >= 0);
+    if (child == 0) {
+      Mapped c(path);
+      for (std::uint64_t step = 0; step < max_steps; ++step) {
+        applyStep(c, seed, step);
+        *progress = step + 1;
+        if (step % 4096 == 4095) {
+          c.sync(deque::SyncMode::async);
+        }
+      }
+      ::_exit(0);
+    }
+
+    ::usleep(static_cast<useconds_t>(2000 + rng() % 40000));
+    ::kill(child, SIGKILL);
+    int status = 0;
+    ::waitpid(child, &status, 0);
+
+    const std::uint64_t completed = *progress;
+    std::deque<std::uint64_t> ref;
+    for (std::uint64_t step = 0; step < completed; ++step) {
+      applyStep(ref, seed, step);
+    }
+    Mapped c(path);
+    if (!sameContents(c, ref)) {
+      applyStep(ref, seed, completed);
+      assert(sameContents(c, ref));
+    }
+
+    // 恢复后的文件仍可继续使用
+    for (std::uint64_t step = completed + 1; step < completed + 5000; ++step) {
+      applyStep(c, seed, step);
+      applyStep(ref, seed, step);
+    }
+    assert(sameContents(c, ref));
+  }
+
+  ::munmap(shared, sizeof(std::uint64_t));
+  std::remove(path.c_str());
+}
+
+void runMappedTests() {
+  testReopenKeepsContents();
+  testReferencesSurviveGrowth();
+  testSteadyStateDoesNotGrowFile();
+  testRejectsMismatchedFiles();
+  testMoveAndSwap();
+  testCrashConsistency();
+}
+
+#else
+
+void runMappedTests() {}
+
+#endif
@@ -0,0 +1,476 @@
+//验证块复用与内存占用（空闲块缓存、映射数组原地居中）
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "deque/deque.hpp"
+
+static void testFifoSteadyStateHasNoAllocations() {
+  deque::Deque<int> d;
+  for (int i = 0; i < 1000; ++i) {
+    d.pushBack(i);
+  }
+
+  // 预热：让映射数组与空闲缓存达到稳态
+  int next = 1000;
+  int expected = 0;
+  for (int i = 0; i < 10000; ++i) {
+    d.pushBack(next++);
+    assert(d.front() == expected);
+    d.popFront();
+    ++expected;
+  }
+
+  auto before = d.blockStats();
+  for (int i = 0; i < 100000; ++i) {
+    d.pushBack(next++);
+    assert(d.front() == expected);
+    d.popFront();
+    ++expected;
+  }
+  auto after = d.blockStats();
+
+  assert(after.block_allocations == before.block_allocations);
+  assert(after.block_deallocations == before.block_deallocations);
+  assert(after.map_allocations == before.map_allocations);
+  assert(after.block_reuses > before.block_reuses);
+  assert(d.size() == 1000);
+}
+
+static void testReverseFifoReusesBlocks() {
+  deque::Deque<int> d;
+  for (int i = 0; i < 500; ++i) {
+    d.pushFront(i);
+  }
+  auto before = d.blockStats();
+  for (int i = 0; i < 50000; ++i) {
+    d.pushFront(i);
+    d.popBack();
+  }
+  auto after = d.blockStats();
+  assert(after.block_allocations - before.block_allocations <= 1);
+  assert(after.block_reuses > before.block_reuses);
+}
+
+static void testSpareBlockLimit() {
+  deque::Deque<int> d;
+  d.setSpareBlockLimit(2);
+  assert(d.spareBlockLimit() == 2);
+  for (std::size_t i = 0; i < d.block_size * 10; ++i) {
+    d.pushBack(static_cast<int>(i));
+  }
+  while (!d.empty()) {
+    d.popBack();
+  }
+  assert(d.blockStats().spare_blocks == 2);
+
+  d.setSpareBlockLimit(0);
+  assert(d.blockStats().spare_blocks == 0);
+  auto stats = d.blockStats();
+  // 除了当前所在块，其余块都已经归还给分配器
+  assert(stats.block_allocations - stats.block_deallocations == 1);
+}
+
+static void testShrinkToFit() {
+  deque::Deque<int> d;
+  const std::size_t block = d.block_size;
+  for (std::size_t i = 0; i < block * 100; ++i) {
+    d.pushBack(static_cast<int>(i));
+  }
+  for (std::size_t i = 0; i < block * 99; ++i) {
+    d.popFront();
+  }
+  d.shrinkToFit();
+  auto stats = d.blockStats();
+  assert(stats.spare_blocks == 0);
+  assert(stats.resident_blocks <= 2);
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i] == static_cast<int>(block * 99 + i));
+  }
+
+  // 收缩之后仍可以在两端继续增长
+  for (int i = 0; i < 1000; ++i) {
+    d.pushFront(-i);
+    d.pushBack(i);
+  }
+  assert(d.size() == block + 2000);
+  assert(d.front() == -999 && d.back() == 999);
+}
+
+// 长时间运行的 FIFO 队列：10^8 次操作后常驻块数必须有界
+static void testLongRunningFifoIsBounded() {
+  constexpr long long kOperations = 100000000;
+  constexpr std::size_t kMaxQueued = 4096;
+
+  // 小块让队列频繁跨块，放大块泄漏的影响
+  deque::Deque<long long, std::allocator<long long>, 64> d;
+  std::size_t peak_resident = 0;
+  long long pushed = 0;
+  long long popped = 0;
+  std::size_t burst = 1;
+  for (long long op = 0; op < kOperations;) {
+    // 突发写入后再排空到一半，队列长度在 [0, kMaxQueued] 内来回摆动
+    for (std::size_t i = 0; i < burst && d.size() < kMaxQueued; ++i, ++op) {
+      d.pushBack(pushed++);
+    }
+    while (d.size() > burst / 2 && op < kOperations) {
+      assert(d.front() == popped);
+      d.popFront();
+      ++popped;
+      ++op;
+    }
+    burst = burst * 2 > kMaxQueued ? 1 : burst * 2;
+    std::size_t resident = d.blockStats().resident_blocks;
+    peak_resident = resident > peak_resident ? resident : peak_resident;
+  }
+
+  std::size_t bound = kMaxQueued / d.block_size + 2 + d.spareBlockLimit();
+  assert(peak_resident <= bound);
+  assert(d.blockStats().map_allocations <= 8);
+}
+
+static void testEmptyDequeOwnsNoMemory() {
+  deque::Deque<int> d;
+  auto stats = d.blockStats();
+  assert(stats.map_allocations == 0);
+  assert(stats.block_allocations == 0);
+  assert(d.begin() == d.end());
+  assert(d.end() - d.begin() == 0);
+  assert(d.segments().begin() == d.segments().end());
+
+  // 空容器的拷贝同样不分配
+  deque::Deque<int> copy(d);
+  assert(copy.blockStats().map_allocations == 0);
+
+  // 在空迭代器位置插入触发第一次分配
+  d.insert(d.end(), 7);
+  assert(d.size() == 1 && d.front() == 7);
+  assert(d.blockStats().map_allocations == 1);
+
+  deque::Deque<int> front_first;
+  front_first.pushFront(1);
+  front_first.pushBack(2);
+  assert(front_first.front() == 1 && front_first.back() == 2);
+
+  // 批量插入也能从未分配状态开始
+  deque::Deque<int> bulk;
+  bulk.resize(d.block_size * 3, 5);
+  assert(bulk.size() == d.block_size * 3 && bulk.back() == 5);
+}
+
+static void testClearKeepsCapacity() {
+  deque::Deque<int> d;
+  const std::size_t count = d.block_size * 20;
+  for (std::size_t i = 0; i < count; ++i) {
+    d.pushBack(static_cast<int>(i));
+  }
+  auto before = d.blockStats();
+  for (int batch = 0; batch < 10; ++batch) {
+    d.clear();
+    assert(d.empty());
+    for (std::size_t i = 0; i < count; ++i) {
+      d.pushBack(static_cast<int>(i));
+    }
+    assert(d.back() == static_cast<int>(count - 1));
+  }
+  auto after = d.blockStats();
+  assert(after.block_allocations == before.block_allocations);
+  assert(after.block_deallocations == before.block_deallocations);
+  assert(after.map_allocations == before.map_allocations);
+
+  // 清空后空闲缓存可以暂时超过上限；shrinkToFit 把内存全部还给分配器
+  d.clear();
+  assert(d.blockStats().spare_blocks > d.spareBlockLimit());
+  d.shrinkToFit();
+  auto released = d.blockStats();
+  assert(released.resident_blocks == 0);
+  assert(d.begin() == d.end());
+  d.pushFront(3);
+  assert(d.size() == 1 && d.back() == 3);
+}
+
+static void testMovedFromDequeIsReusable() {
+  deque::Deque<int> source;
+  for (int i = 0; i < 100; ++i) {
+    source.pushBack(i);
+  }
+  deque::Deque<int> target(std::move(source));
+  assert(target.size() == 100);
+  assert(source.empty());  // NOLINT(bugprone-use-after-move)
+  assert(source.begin() == source.end());
+  for (int i = 0; i < 100; ++i) {
+    source.pushFront(i);
+    source.pushBack(i);
+  }
+  assert(source.size() == 200 && source.front() == 99 && source.back() == 99);
+
+  deque::Deque<int> assigned;
+  assigned = std::move(source);
+  source.clear();
+  source.assign(3, 3);
+  assert(source.size() == 3 && source[2] == 3);
+}
+
+// 预留之后连续 capacityBack()/capacityFront() 次推入都不能触发分配或复用缓存块。
+template <class D>
+static void checkReservedPushes(D& d, std::size_t count, bool back) {
+  if (back) {
+    d.reserveBack(count);
+  } else {
+    d.reserveFront(count);
+  }
+  std::size_t capacity = back ? d.capacityBack() : d.capacityFront();
+  assert(capacity >= count);
+  auto before = d.blockStats();
+  std::size_t old_size = d.size();
+  for (std::size_t i = 0; i < capacity; ++i) {
+    if (back) {
+      d.pushBack(static_cast<int>(i));
+    } else {
+      d.pushFront(static_cast<int>(i));
+    }
+  }
+  auto after = d.blockStats();
+  assert(after.block_allocations == before.block_allocations);
+  assert(after.block_reuses == before.block_reuses);
+  assert(after.map_allocations == before.map_allocations);
+  assert(d.size() == old_size + capacity);
+  assert((back ? d.back() : d.front()) == static_cast<int>(capacity - 1));
+}
+
+template <std::size_t BlockSize>
+static void testReserveSweep() {
+  using D = deque::Deque<int, std::allocator<int>, BlockSize>;
+  const std::size_t counts[] = {1, BlockSize - 1, BlockSize, BlockSize + 1, 3 * BlockSize, 37 * BlockSize + 5};
+  for (std::size_t prefill : {std::size_t{0}, std::size_t{1}, BlockSize / 2, 5 * BlockSize + 3}) {
+    for (std::size_t count : counts) {
+      for (bool back : {true, false}) {
+        D d;
+        for (std::size_t i = 0; i < prefill; ++i) {
+          d.pushBack(-1);
+        }
+        checkReservedPushes(d, count, back);
+        // 再预留一次：已有的剩余容量也要算进去
+        checkReservedPushes(d, count, !back);
+      }
+    }
+  }
+}
+
+static void testReservationSurvivesMapGrowth() {
+  deque::Deque<int, std::allocator<int>, 16> d;
+  d.reserveBack(16 * 40);
+  std::size_t reserved = d.capacityBack();
+  auto before = d.blockStats();
+  // 在另一端大量推入，映射数组会多次扩容/居中，末尾的预留块必须随之搬移
+  for (int i = 0; i < 16 * 200; ++i) {
+    d.pushFront(i);
+  }
+  assert(d.blockStats().map_allocations > before.map_allocations);
+  assert(d.capacityBack() >= reserved);
+  checkReservedPushes(d, reserved, true);
+
+  // 从预留的一端弹出时预留容量保持不变，常驻块数不会随流量增长
+  deque::Deque<int, std::allocator<int>, 16> fifo;
+  fifo.reserveFront(16 * 8);
+  std::size_t front_capacity = fifo.capacityFront();
+  for (int i = 0; i < 16 * 4; ++i) {
+    fifo.pushBack(i);
+  }
+  std::size_t resident = fifo.blockStats().resident_blocks;
+  for (int i = 0; i < 100000; ++i) {
+    fifo.pushBack(i);
+    fifo.popFront();
+    assert(fifo.blockStats().resident_blocks <= resident + 1);
+  }
+  assert(fifo.capacityFront() >= front_capacity);
+
+  // shrinkToFit 归还全部预留块
+  fifo.shrinkToFit();
+  assert(fifo.capacityFront() < 16 * 8);
+  assert(fifo.blockStats().resident_blocks <= fifo.size() / 16 + 2);
+}
+
+using GrowthDeque = deque::Deque<int, std::allocator<int>, 16>;
+
+// 只在一端推入 count 个元素，返回映射数组的分配次数与原地搬移次数之和。
+static std::size_t mapRelayouts(const GrowthDeque::map_growth_policy& policy, bool back, std::size_t count) {
+  GrowthDeque d;
+  d.setMapGrowthPolicy(policy);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (back) {
+      d.pushBack(static_cast<int>(i));
+    } else {
+      d.pushFront(static_cast<int>(i));
+    }
+  }
+  auto stats = d.blockStats();
+  assert(back ? stats.blocks_pushed_front == 0 : stats.blocks_pushed_back == 0);
+  assert((back ? stats.blocks_pushed_back : stats.blocks_pushed_front) >= count / d.block_size);
+  if (!policy.recenter_in_place) {
+    assert(stats.map_recenters == 0);
+  }
+  return stats.map_allocations + stats.map_recenters;
+}
+
+static void testMapGrowthPolicy() {
+  GrowthDeque::map_growth_policy centered;
+  centered.bias_to_hot_end = false;
+  GrowthDeque::map_growth_policy biased;
+  const std::size_t count = 16 * 5000;
+  for (bool back : {true, false}) {
+    assert(mapRelayouts(biased, back, count) <= mapRelayouts(centered, back, count));
+  }
+
+  GrowthDeque::map_growth_policy slow;
+  slow.growth_factor = 1.5;
+  GrowthDeque::map_growth_policy fast;
+  fast.growth_factor = 4.0;
+  assert(mapRelayouts(fast, true, count) < mapRelayouts(slow, true, count));
+
+  GrowthDeque::map_growth_policy no_recenter;
+  no_recenter.recenter_in_place = false;
+  mapRelayouts(no_recenter, false, count);
+
+  // 只在末尾推入、从前端弹出的 FIFO：偏向热端后原地搬移更少
+  auto fifoRecenters = [](const GrowthDeque::map_growth_policy& policy) {
+    GrowthDeque d;
+    d.setMapGrowthPolicy(policy);
+    for (int i = 0; i < 16 * 64; ++i) {
+      d.pushBack(i);
+    }
+    for (int i = 0; i < 200000; ++i) {
+      d.pushBack(i);
+      d.popFront();
+    }
+    return d.blockStats().map_recenters;
+  };
+  assert(fifoRecenters(biased) < fifoRecenters(centered));
+
+  // 策略随复制、移动和交换一起传递
+  GrowthDeque d;
+  d.setMapGrowthPolicy(fast);
+  d.pushBack(1);
+  GrowthDeque copy(d);
+  assert(copy.mapGrowthPolicy().growth_factor == 4.0);
+  GrowthDeque moved(std::move(copy));
+  assert(moved.mapGrowthPolicy().growth_factor == 4.0);
+  GrowthDeque other;
+  other.swap(moved);
+  assert(other.mapGrowthPolicy().growth_factor == 4.0);
+  assert(moved.mapGrowthPolicy().growth_factor == 2.0);
+}
+
+// 搬移进行中：提前分配的映射数组还没有切换过去
+static bool migrating(const GrowthDeque& d) {
+  auto stats = d.blockStats();
+  return stats.map_allocations > stats.map_migrations + 1;
+}
+
+static void testIncrementalMapGrowth() {
+  GrowthDeque::map_growth_policy incremental;
+  incremental.incremental = true;
+
+  // 单向推入时每次增长都经由增量搬移完成：除初始映射数组外，每次分配都对应一次切换
+  for (bool back : {true, false}) {
+    GrowthDeque d;
+    d.setMapGrowthPolicy(incremental);
+    for (int i = 0; i < 16 * 20000; ++i) {
+      if (back) {
+        d.pushBack(i);
+      } else {
+        d.pushFront(i);
+      }
+    }
+    auto stats = d.blockStats();
+    assert(stats.map_migrations > 5);
+    assert(stats.map_recenters == 0);
+    assert(stats.map_allocations == stats.map_migrations + 1 || migrating(d));
+    for (int i = 0; i < 16 * 20000; i += 997) {
+      assert(d[static_cast<std::size_t>(back ? i : 16 * 20000 - 1 - i)] == i);
+    }
+  }
+
+  // FIFO 稳态：持有的块保持有界，也不再原地搬移
+  GrowthDeque fifo;
+  fifo.setMapGrowthPolicy(incremental);
+  for (int i = 0; i < 16 * 64; ++i) {
+    fifo.pushBack(i);
+  }
+  for (int i = 0; i < 200000; ++i) {
+    fifo.pushBack(i);
+    fifo.popFront();
+  }
+  assert(fifo.blockStats().map_recenters == 0);
+  assert(fifo.blockStats().map_migrations > 0);
+  assert(fifo.blockStats().resident_blocks <= 64 + 2 + fifo.spareBlockLimit());
+
+  // 搬移进行中时移动、交换、拆分拼接、收缩、关闭增量增长以及反方向推入都要正确处理提前分配的映射数组
+  for (int op = 0; op < 6; ++op) {
+    GrowthDeque d;
+    d.setMapGrowthPolicy(incremental);
+    std::deque<int> expected;
+    int next = 0;
+    while (d.blockStats().map_migrations < 3 || !migrating(d)) {
+      d.pushBack(next);
+      expected.push_back(next++);
+    }
+    const int* first = &d.front();
+    std::size_t migrations = d.blockStats().map_migrations;
+    if (op == 0) {
+      GrowthDeque moved(std::move(d));
+      d = std::move(moved);
+    } else if (op == 1) {
+      GrowthDeque other;
+      other.swap(d);
+      d.swap(other);
+    } else if (op == 2) {
+      GrowthDeque tail = d.splitAt(d.size() / 3);
+      d.appendSplice(std::move(tail));
+    } else if (op == 3) {
+      d.shrinkToFit();
+    } else if (op == 4) {
+      d.setMapGrowthPolicy(GrowthDeque::map_growth_policy{});
+    } else {
+      for (int i = 0; i < 16 * 100; ++i) {
+        d.pushFront(-i);
+        expected.push_front(-i);
+      }
+    }
+    for (int i = 0; i < 16 * 2000; ++i) {
+      d.pushBack(next);
+      expected.push_back(next++);
+    }
+    assert(d.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      assert(d[i] == expected[i]);
+    }
+    if (op < 2) {
+      // 切换映射数组不移动元素，引用保持有效；移动和交换连同进行中的搬移一起转交
+      assert(first == &d.front());
+      assert(d.blockStats().map_migrations > migrations);
+    }
+    if (op == 4) {
+      assert(d.blockStats().map_migrations == migrations);
+    }
+  }
+}
+
+void runMemoryTests() {
+  testFifoSteadyStateHasNoAllocations();
+  testReverseFifoReusesBlocks();
+  testSpareBlockLimit();
+  testShrinkToFit();
+  testLongRunningFifoIsBounded();
+  testEmptyDequeOwnsNoMemory();
+  testClearKeepsCapacity();
+  testMovedFromDequeIsReusable();
+  testReserveSweep<16>();
+  testReserveSweep<24>();
+  testReserveSweep<1024>();
+  testReservationSurvivesMapGrowth();
+  testMapGrowthPolicy();
+  testIncrementalMapGrowth();
+}
@@ -1,9 +1,168 @@
 //验证“修改类接口”（assign/insert/erase/resize/swap）
 #include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "deque/deque.hpp"
 
+// 靠近两端的插入/删除会走不同的移动方向，逐一与 std::deque 对比
+static void testShorterSideShifting() {
+  deque::Deque<std::string> d;
+  std::deque<std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    d.pushBack(std::to_string(i));
+    expected.push_back(std::to_string(i));
+  }
+
+  const std::size_t positions[] = {1, 5, 63, 64, 65, 130, 499, 500, 501, 870, 936, 998};
+  for (std::size_t pos : positions) {
+    d.insert(d.begin() + static_cast<std::ptrdiff_t>(pos), "x" + std::to_string(pos));
+    expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), "x" + std::to_string(pos));
+  }
+  // 插入容器内已有元素的引用
+  d.insert(d.begin() + 3, d[700]);
+  expected.insert(expected.begin() + 3, expected[700]);
+  d.insert(d.begin() + 900, d[10]);
+  expected.insert(expected.begin() + 900, expected[10]);
+
+  for (std::size_t pos : positions) {
+    auto it = d.erase(d.begin() + static_cast<std::ptrdiff_t>(pos));
+    expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+    assert(it.getIndex() == pos);
+  }
+
+  auto it = d.erase(d.begin() + 10, d.begin() + 150);
+  expected.erase(expected.begin() + 10, expected.begin() + 150);
+  assert(it.getIndex() == 10);
+  it = d.erase(d.end() - 200, d.end() - 70);
+  expected.erase(expected.end() - 200, expected.end() - 70);
+  assert(it == d.end() - 70);
+
+  assert(d.size() == expected.size());
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i] == expected[i]);
+  }
+}
+
+struct Tick {
+  long long timestamp;
+  double price;
+  int id;
+};
+
+// 平凡可复制类型走 memcpy/memmove 路径，结果必须与逐元素路径一致
+static void testTriviallyCopyablePaths() {
+  deque::Deque<Tick> d;
+  std::deque<Tick> expected;
+  for (int i = 0; i < 1000; ++i) {
+    Tick t{i * 10LL, i * 0.5, i};
+    if (i % 3 == 0) {
+      d.pushFront(t);
+      expected.push_front(t);
+    } else {
+      d.pushBack(t);
+      expected.push_back(t);
+    }
+  }
+
+  deque::Deque<Tick> copy(d);
+  std::deque<Tick> original = expected;
+  d.erase(d.begin() + 100, d.begin() + 250);
+  expected.erase(expected.begin() + 100, expected.begin() + 250);
+  d.erase(d.begin() + 700, d.begin() + 800);
+  expected.erase(expected.begin() + 700, expected.begin() + 800);
+  d.insert(d.begin() + 3, Tick{-1, -1.0, -1});
+  expected.insert(expected.begin() + 3, Tick{-1, -1.0, -1});
+  d.resize(1500, Tick{7, 7.0, 7});
+  expected.resize(1500, Tick{7, 7.0, 7});
+  d.resize(600);
+  expected.resize(600);
+
+  assert(d.size() == expected.size());
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i].timestamp == expected[i].timestamp && d[i].id == expected[i].id);
+  }
+  assert(copy.size() == original.size());
+  for (std::size_t i = 0; i < copy.size(); ++i) {
+    assert(copy[i].timestamp == original[i].timestamp && copy[i].id == original[i].id);
+  }
+  copy.clear();
+  assert(copy.empty());
+}
+
+static void testCopyConstruction() {
+  deque::Deque<std::string> d;
+  for (int i = 0; i < 300; ++i) {
+    d.pushFront(std::to_string(i));
+  }
+  deque::Deque<std::string> copy(d);
+  assert(copy == d);
+  copy.popFront();
+  copy.pushBack("tail");
+  assert(copy != d && d.size() == 300 && copy.back() == "tail");
+}
+
+// 统计拷贝/移动次数的类型
+struct Tracked {
+  static int copies;
+  static int moves;
+
+  std::string name;
+  int value = 0;
+
+  Tracked(std::string n, int v) : name(std::move(n)), value(v) {}
+  Tracked(const Tracked& other) : name(other.name), value(other.value) { ++copies; }
+  Tracked(Tracked&& other) noexcept : name(std::move(other.name)), value(other.value) { ++moves; }
+  Tracked& operator=(const Tracked& other) {
+    name = other.name;
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  Tracked& operator=(Tracked&& other) noexcept {
+    name = std::move(other.name);
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+};
+
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+static void testEmplace() {
+  deque::Deque<Tracked, std::allocator<Tracked>, 16> d;
+  Tracked::copies = 0;
+  Tracked::moves = 0;
+  for (int i = 0; i < 100; ++i) {
+    Tracked& back = d.emplaceBack("b" + std::to_string(i), i);
+    assert(back.value == i);
+    Tracked& front = d.emplaceFront("f" + std::to_string(i), -i);
+    assert(front.value == -i);
+  }
+  // 两端原地构造，不产生任何拷贝或移动
+  assert(Tracked::copies == 0 && Tracked::moves == 0);
+  assert(d.size() == 200 && d.front().name == "f99" && d.back().name == "b99");
+
+  auto it = d.emplace(d.begin() + 20, "mid", 1000);
+  assert(it.getIndex() == 20 && it->name == "mid" && d[21].name == "f79");
+  it = d.emplace(d.end() - 5, "tail", 2000);
+  assert(it->value == 2000 && d[d.size() - 6].name == "tail");
+  it = d.emplace(d.begin(), "head", 3000);
+  assert(it == d.begin() && d.front().value == 3000);
+  it = d.emplace(d.end(), "end", 4000);
+  assert(d.back().value == 4000);
+
+  // 插入右值：只移动不拷贝
+  Tracked::copies = 0;
+  d.insert(d.begin() + 50, Tracked("moved", 5));
+  assert(Tracked::copies == 0 && d[50].name == "moved");
+  assert(d.size() == 205);
+}
+
 void runModifierTests() {
   deque::Deque<int> d;
 
@@ -53,4 +212,9 @@ void runModifierTests() {
   assert(d.size() == 2);
   assert(d[0] == 100 && d[1] == 200);
   assert(other.size() == 3);
+
+  testShorterSideShifting();
+  testTriviallyCopyablePaths();
+  testCopyConstruction();
+  testEmplace();
 }
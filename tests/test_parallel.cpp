@@ -0,0 +1,250 @@
+//验证并行算法 deque::parallel（按块切分、各执行器、排序与稳定排序、异常传播）
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "deque/deque.hpp"
+#include "deque/parallel.hpp"
+
+namespace {
+
+using SmallBlocks = deque::Deque<std::uint64_t, std::allocator<std::uint64_t>, 64>;
+
+// 头部推入一些元素，使区间起点落在块中间
+SmallBlocks makeNumbers(std::size_t count) {
+  SmallBlocks d;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 7 == 0) {
+      d.pushFront(i);
+    } else {
+      d.pushBack(i);
+    }
+  }
+  return d;
+}
+
+std::vector<std::uint64_t> toVector(const SmallBlocks& d) { return std::vector<std::uint64_t>(d.begin(), d.end()); }
+
+}  // namespace
+
+static void testBlockPartition() {
+  SmallBlocks d = makeNumbers(5000);
+  for (std::size_t skip : {0, 1, 63, 64, 100}) {
+    auto first = d.begin() + static_cast<std::ptrdiff_t>(skip);
+    auto last = d.end() - 3;
+    for (std::size_t max_parts : {1, 2, 3, 8, 1000}) {
+      deque::detail::BlockPartition partition(first, last, max_parts);
+      assert(partition.parts() >= 1 && partition.parts() <= max_parts);
+      assert(partition.offset(0) == 0);
+      assert(partition.offset(partition.parts()) == static_cast<std::size_t>(last - first));
+      for (std::size_t part = 1; part < partition.parts(); ++part) {
+        auto boundary = first + static_cast<std::ptrdiff_t>(partition.offset(part));
+        assert(partition.offset(part) > partition.offset(part - 1));
+        // 内部分界点都在块的起点：从这里开始的第一段是整块，或一直延伸到末尾的最后一块
+        auto segment = *d.segments(boundary, d.end()).begin();
+        assert(segment.size() == SmallBlocks::block_size ||
+               boundary + static_cast<std::ptrdiff_t>(segment.size()) == d.end());
+      }
+    }
+  }
+
+  deque::detail::BlockPartition empty(d.begin(), d.begin(), 4);
+  assert(empty.parts() == 0);
+}
+
+static void testThreadPool() {
+  deque::parallel::ThreadPool pool(4);
+  assert(pool.concurrency() == 4);
+
+  std::vector<std::atomic<int>> hits(1000);
+  pool.run(hits.size(), [&](std::size_t index) { hits[index].fetch_add(1); });
+  for (auto& hit : hits) {
+    assert(hit.load() == 1);
+  }
+
+  // 任务中再次调用 run 在当前线程上执行，不会死锁
+  std::atomic<int> nested{0};
+  pool.run(8, [&](std::size_t) { pool.run(4, [&](std::size_t) { nested.fetch_add(1); }); });
+  assert(nested.load() == 32);
+
+  bool thrown = false;
+  try {
+    pool.run(100, [](std::size_t index) {
+      if (index == 42) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  // 抛出异常后线程池仍可继续使用
+  std::atomic<int> after{0};
+  pool.run(10, [&](std::size_t) { after.fetch_add(1); });
+  assert(after.load() == 10);
+}
+
+template <class Executor>
+static void checkAlgorithms(Executor& executor) {
+  for (std::size_t count : {0, 1, 100, 20000, 100000}) {
+    SmallBlocks d = makeNumbers(count);
+    const std::vector<std::uint64_t> original = toVector(d);
+
+    std::uint64_t expected_sum = std::accumulate(original.begin(), original.end(), std::uint64_t{5});
+    assert(deque::parallel::reduce(executor, d.cbegin(), d.cend(), std::uint64_t{5}) == expected_sum);
+
+    // 非交换的结合运算：按顺序拼接首尾
+    if (count > 0) {
+      using Ends = std::pair<std::uint64_t, std::uint64_t>;
+      std::vector<Ends> ends;
+      for (std::uint64_t value : original) {
+        ends.emplace_back(value, value);
+      }
+      auto concat = [](Ends a, Ends b) { return Ends(a.first, b.second); };
+      deque::Deque<Ends, std::allocator<Ends>, 64> ends_deque;
+      for (const Ends& e : ends) {
+        ends_deque.pushBack(e);
+      }
+      Ends joined =
+          deque::parallel::reduce(executor, ends_deque.begin() + 1, ends_deque.end(), ends_deque.front(), concat);
+      assert(joined.first == original.front() && joined.second == original.back());
+    }
+
+    std::atomic<std::uint64_t> visited_sum{0};
+    deque::parallel::forEach(executor, d.begin(), d.end(), [&](std::uint64_t& value) {
+      visited_sum.fetch_add(value, std::memory_order_relaxed);
+      value *= 2;
+    });
+    assert(visited_sum.load() + 5 == expected_sum);
+    for (std::size_t i = 0; i < count; ++i) {
+      assert(d[i] == original[i] * 2);
+    }
+
+    // 输出到另一个 Deque 与 std::vector
+    SmallBlocks out;
+    out.resize(count + 10);
+    auto out_end = deque::parallel::transform(executor, d.cbegin(), d.cend(), out.begin() + 10,
+                                              [](std::uint64_t value) { return value + 1; });
+    assert(out_end == out.end());
+    std::vector<std::uint64_t> copied(count);
+    deque::parallel::copy(executor, out.cbegin() + 10, out.cend(), copied.begin());
+    for (std::size_t i = 0; i < count; ++i) {
+      assert(copied[i] == original[i] * 2 + 1);
+    }
+
+    deque::parallel::fill(executor, d.begin(), d.end(), std::uint64_t{9});
+    assert(std::all_of(d.begin(), d.end(), [](std::uint64_t value) { return value == 9; }));
+  }
+}
+
+template <class Executor>
+static void checkSorts(Executor& executor) {
+  std::mt19937_64 rng(17);
+  for (std::size_t count : {0, 1, 2, 1000, 16384, 70001, 200000}) {
+    SmallBlocks d = makeNumbers(count);
+    for (auto& value : d) {
+      value = rng() % (count / 4 + 1);
+    }
+    std::vector<std::uint64_t> expected = toVector(d);
+    std::sort(expected.begin(), expected.end());
+    deque::parallel::sort(executor, d.begin(), d.end());
+    assert(toVector(d) == expected);
+
+    // 降序与子区间
+    if (count > 10) {
+      std::vector<std::uint64_t> sub = toVector(d);
+      std::shuffle(sub.begin(), sub.end(), rng);
+      std::copy(sub.begin(), sub.end(), d.begin());
+      deque::parallel::sort(executor, d.begin() + 3, d.end() - 5, std::greater<>());
+      std::sort(sub.begin() + 3, sub.end() - 5, std::greater<>());
+      assert(toVector(d) == sub);
+    }
+  }
+
+  // 稳定排序：按 key 排序后，相等 key 的原始序号保持递增
+  using Item = std::pair<std::uint32_t, std::uint32_t>;
+  for (std::size_t count : {0, 5, 30000, 150000}) {
+    deque::Deque<Item, std::allocator<Item>, 128> items;
+    for (std::size_t i = 0; i < count; ++i) {
+      items.pushBack(Item(static_cast<std::uint32_t>(rng() % 50), static_cast<std::uint32_t>(i)));
+    }
+    std::vector<Item> expected(items.begin(), items.end());
+    auto by_key = [](const Item& a, const Item& b) { return a.first < b.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    deque::parallel::stableSort(executor, items.begin(), items.end(), by_key);
+    assert(std::equal(items.begin(), items.end(), expected.begin(), expected.end()));
+  }
+
+  // 非平凡类型
+  deque::Deque<std::string> words;
+  for (int i = 0; i < 40000; ++i) {
+    words.pushBack(std::to_string(rng() % 100000));
+  }
+  std::vector<std::string> expected_words(words.begin(), words.end());
+  std::sort(expected_words.begin(), expected_words.end());
+  deque::parallel::sort(executor, words.begin(), words.end());
+  assert(std::equal(words.begin(), words.end(), expected_words.begin(), expected_words.end()));
+}
+
+static void testExecutors() {
+  deque::parallel::InlineExecutor inline_executor;
+  checkAlgorithms(inline_executor);
+  checkSorts(inline_executor);
+
+  for (std::size_t threads : {2, 3, 8}) {
+    deque::parallel::ThreadPool pool(threads);
+    checkAlgorithms(pool);
+    checkSorts(pool);
+  }
+
+  // 不传执行器时使用默认线程池
+  SmallBlocks d = makeNumbers(50000);
+  std::vector<std::uint64_t> expected = toVector(d);
+  std::sort(expected.begin(), expected.end());
+  deque::parallel::sort(d.begin(), d.end());
+  assert(toVector(d) == expected);
+  deque::parallel::stableSort(d.begin(), d.end(), std::greater<>());
+  assert(std::is_sorted(d.begin(), d.end(), std::greater<>()));
+  assert(deque::parallel::reduce(d.cbegin(), d.cend(), std::uint64_t{0}) ==
+         std::accumulate(expected.begin(), expected.end(), std::uint64_t{0}));
+  deque::parallel::forEach(d.begin(), d.end(), [](std::uint64_t& value) { value = 1; });
+  deque::parallel::fill(d.begin(), d.begin() + 10, std::uint64_t{0});
+  assert(deque::parallel::reduce(d.begin(), d.end(), std::uint64_t{0}, std::plus<>()) == d.size() - 10);
+  std::vector<std::uint64_t> copied(d.size());
+  deque::parallel::transform(d.begin(), d.end(), copied.begin(), [](std::uint64_t value) { return value * 3; });
+  deque::parallel::copy(d.begin(), d.end(), copied.begin());
+  assert(std::equal(copied.begin(), copied.end(), d.begin()));
+}
+
+static void testExceptionPropagates() {
+  deque::parallel::ThreadPool pool(4);
+  SmallBlocks d = makeNumbers(100000);
+  bool thrown = false;
+  try {
+    deque::parallel::forEach(pool, d.begin(), d.end(), [](std::uint64_t value) {
+      if (value == 77777) {
+        throw std::runtime_error("bad element");
+      }
+    });
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+void runParallelTests() {
+  testBlockPartition();
+  testThreadPool();
+  testExecutors();
+  testExceptionPropagates();
+}
@@ -0,0 +1,233 @@
+//验证定长环形队列 RingDeque（编译期与运行期容量）
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "deque/ring_deque.hpp"
+
+template <class Ring, class T>
+static void assertSame(const Ring& ring, const std::deque<T>& expected) {
+  assert(ring.size() == expected.size());
+  assert(std::equal(ring.begin(), ring.end(), expected.begin(), expected.end()));
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    assert(ring[i] == expected[i]);
+  }
+  assert(std::equal(ring.rBegin(), ring.rEnd(), expected.rbegin(), expected.rend()));
+}
+
+static void testStaticCapacity() {
+  deque::RingDeque<int, 5> ring;
+  static_assert(sizeof(ring) < 5 * sizeof(int) + 64, "storage is inline");
+  assert(ring.empty() && ring.capacity() == 5);
+
+  std::deque<int> expected;
+  for (int i = 0; i < 5; ++i) {
+    i % 2 == 0 ? ring.pushBack(i) : ring.pushFront(i);
+    i % 2 == 0 ? expected.push_back(i) : expected.push_front(i);
+  }
+  assert(ring.full());
+  assert(!ring.tryPushBack(99));
+  assert(!ring.tryPushFront(99));
+  assertSame(ring, expected);
+
+  ring.popFront();
+  expected.pop_front();
+  ring.popBack();
+  expected.pop_back();
+  assertSame(ring, expected);
+
+  // 迭代器跨越环绕点的算术与排序。
+  std::sort(ring.begin(), ring.end());
+  std::sort(expected.begin(), expected.end());
+  assertSame(ring, expected);
+  assert(ring.end() - ring.begin() == 3);
+  assert(*(ring.begin() + 2) == expected[2]);
+}
+
+static void testOverwritePolicy() {
+  deque::DynamicRingDeque<std::string> window(3, deque::OverflowPolicy::overwrite);
+  assert(window.capacity() == 3);
+  for (int i = 0; i < 10; ++i) {
+    window.pushBack(std::to_string(i));
+  }
+  assert(window.size() == 3);
+  assert(window.front() == "7" && window.back() == "9");
+
+  // pushFront 丢弃的是另一端（back）。
+  window.pushFront("x");
+  assert(window.front() == "x" && window.back() == "8");
+
+  // 参数引用即将被覆盖的元素时仍然正确。
+  window.pushBack(window.front());
+  assert(window.front() == "7" && window.back() == "x");
+  assert(window.size() == 3);
+}
+
+template <class Ring>
+static void runRandomAgainstStd(Ring& ring, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::deque<int> expected;
+  for (int step = 0; step < 20000; ++step) {
+    switch (rng() % 5) {
+      case 0:
+      case 1:
+        if (ring.overflowPolicy() == deque::OverflowPolicy::overwrite && expected.size() == ring.capacity()) {
+          expected.pop_front();
+        }
+        if (ring.overflowPolicy() == deque::OverflowPolicy::overwrite || !ring.full()) {
+          ring.pushBack(step);
+          expected.push_back(step);
+        }
+        break;
+      case 2:
+        if (!ring.full()) {
+          ring.pushFront(step);
+          expected.push_front(step);
+        }
+        break;
+      case 3:
+        if (!expected.empty()) {
+          ring.popFront();
+          expected.pop_front();
+        }
+        break;
+      default:
+        if (!expected.empty()) {
+          ring.popBack();
+          expected.pop_back();
+        }
+        break;
+    }
+    assert(ring.size() == expected.size());
+    if (!expected.empty()) {
+      assert(ring.front() == expected.front() && ring.back() == expected.back());
+    }
+  }
+  assertSame(ring, expected);
+}
+
+static void testRandomOperations() {
+  deque::RingDeque<int, 16> power_of_two;
+  runRandomAgainstStd(power_of_two, 1);
+  deque::RingDeque<int, 13> odd;
+  runRandomAgainstStd(odd, 2);
+  deque::DynamicRingDeque<int> dynamic(100, deque::OverflowPolicy::overwrite);
+  runRandomAgainstStd(dynamic, 3);
+}
+
+static void testCopyMoveSwap() {
+  deque::RingDeque<std::string, 4> a;
+  a.pushBack("a");
+  a.pushBack("b");
+  auto b = a;
+  assert(b == a);
+  b.pushFront("z");
+  assert(b != a && a < b);
+
+  auto c = std::move(b);
+  assert(c.size() == 3 && c.front() == "z");
+  assert(b.empty());
+  swap(a, c);
+  assert(a.size() == 3 && c.size() == 2);
+
+  deque::DynamicRingDeque<std::string> d(6);
+  d.pushBack("x");
+  deque::DynamicRingDeque<std::string> e(2);
+  e = d;
+  assert(e.capacity() == 6 && e == d);
+  deque::DynamicRingDeque<std::string> f(std::move(e));
+  assert(f.size() == 1 && f.capacity() == 6);
+  // 移动构造接管缓冲区：被移动的对象容量为 0，推入失败，赋值后可以继续使用
+  assert(e.empty() && e.capacity() == 0);
+  assert(!e.tryPushBack("full") && !e.tryPushFront("full"));
+  deque::DynamicRingDeque<std::string> copy_of_empty(e);
+  assert(copy_of_empty.capacity() == 0);
+  e = deque::DynamicRingDeque<std::string>(2);
+  e.pushBack("still usable");
+  assert(e.size() == 1);
+  f = std::move(e);
+  assert(f.size() == 1 && f.capacity() == 2);
+
+  // 移动不分配，也不抛出：vector 扩容时移动而不是复制，缓冲区随之转移
+  static_assert(std::is_nothrow_move_constructible_v<deque::DynamicRingDeque<int>>);
+  std::vector<deque::DynamicRingDeque<int>> rings;
+  rings.emplace_back(4);
+  rings.back().pushBack(7);
+  const int* element = &rings.front().front();
+  for (int i = 0; i < 16; ++i) {
+    rings.emplace_back(4);
+  }
+  assert(&rings.front().front() == element && *element == 7);
+}
+
+// 从单调资源分配，并记录尚未归还的字节数；从别的资源分配的缓冲区还到这里时计数变为负数
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  long outstanding = 0;
+
+ private:
+  std::pmr::monotonic_buffer_resource upstream_;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    outstanding += static_cast<long>(bytes);
+    return upstream_.allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    outstanding -= static_cast<long>(bytes);
+    assert(outstanding >= 0);
+    upstream_.deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+static void testPmrAllocators() {
+  using PmrRing = deque::DynamicRingDeque<std::string, std::pmr::polymorphic_allocator<std::string>>;
+  CountingResource first;
+  CountingResource second;
+  {
+    PmrRing a(8, deque::OverflowPolicy::reject, &first);
+    PmrRing b(4, deque::OverflowPolicy::overwrite, &second);
+    a.pushBack("a");
+    b.pushBack("b1");
+    b.pushBack("b2");
+
+    // pmr 分配器不随移动赋值传播且两者不相等：从自己的资源申请缓冲区，逐个移动元素
+    a = std::move(b);
+    assert(a.getAllocator().resource() == &first);
+    assert(a.capacity() == 4 && a.size() == 2 && a.front() == "b1");
+    assert(a.overflowPolicy() == deque::OverflowPolicy::overwrite);
+    assert(b.empty() && b.getAllocator().resource() == &second);
+
+    // 拷贝赋值同样保留自己的资源
+    b.pushBack("c");
+    a = b;
+    assert(a.getAllocator().resource() == &first && a.size() == 1 && a.front() == "c");
+
+    // 移动构造沿用源对象的资源，之后两者相等，交换只交换缓冲区
+    PmrRing c(std::move(a));
+    assert(c.getAllocator().resource() == &first);
+    PmrRing d(2, deque::OverflowPolicy::reject, &first);
+    d.pushBack("d");
+    swap(c, d);
+    assert(c.front() == "d" && d.front() == "c");
+    a = std::move(d);
+    assert(a.front() == "c" && a.getAllocator().resource() == &first);
+  }
+  // 每个缓冲区都归还给了申请它的资源
+  assert(first.outstanding == 0 && second.outstanding == 0);
+}
+
+void runRingTests() {
+  testStaticCapacity();
+  testOverwritePolicy();
+  testRandomOperations();
+  testCopyMoveSwap();
+  testPmrAllocators();
+}
@@ -0,0 +1,129 @@
+//验证分段视图 segments() 与分段算法
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "deque/algorithm.hpp"
+#include "deque/deque.hpp"
+
+static void testSegmentsCoverRange() {
+  using SmallDeque = deque::Deque<int, std::allocator<int>, 8>;
+  SmallDeque d;
+  assert(d.segments().empty());
+
+  for (int i = 0; i < 50; ++i) {
+    d.pushBack(i);
+  }
+  for (int i = 1; i <= 13; ++i) {
+    d.pushFront(-i);
+  }
+
+  // 拼接全部分段应得到原序列，且除首尾外每段都是整块。
+  std::vector<int> joined;
+  std::size_t segment_count = 0;
+  for (auto segment : d.segments()) {
+    assert(!segment.empty());
+    assert(segment.size() <= SmallDeque::block_size);
+    joined.insert(joined.end(), segment.begin(), segment.end());
+    ++segment_count;
+  }
+  assert(joined.size() == d.size());
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(joined[i] == d[i]);
+  }
+  assert(segment_count == 9);
+
+  // 任意子区间，包括落在块边界上的端点和空区间。
+  for (std::size_t first = 0; first <= d.size(); ++first) {
+    for (std::size_t last = first; last <= d.size(); ++last) {
+      std::size_t total = 0;
+      int expected = d.front() + static_cast<int>(first);
+      for (auto segment : d.segments(d.begin() + first, d.begin() + last)) {
+        for (int value : segment) {
+          assert(value == expected++);
+        }
+        total += segment.size();
+      }
+      assert(total == last - first);
+    }
+  }
+}
+
+static void testSegmentsMutate() {
+  deque::Deque<double> d;
+  for (int i = 0; i < 10000; ++i) {
+    d.pushBack(1.0);
+  }
+  for (auto segment : d.segments()) {
+    for (std::size_t i = 0; i < segment.size(); ++i) {
+      segment[i] *= 2.0;
+    }
+  }
+  for (double value : d) {
+    assert(value == 2.0);
+  }
+
+  // 可以像 iovec 一样整段 memcpy 出去。
+  std::vector<double> out(d.size());
+  std::size_t written = 0;
+  const auto& cd = d;
+  for (deque::Deque<double>::const_segment segment : cd.segments()) {
+    std::memcpy(out.data() + written, segment.data(), segment.sizeBytes());
+    written += segment.size();
+  }
+  assert(written == out.size());
+  assert(std::accumulate(out.begin(), out.end(), 0.0) == 20000.0);
+}
+
+static void testSegmentedAlgorithms() {
+  deque::Deque<std::string, std::allocator<std::string>, 4> d;
+  std::deque<std::string> expected;
+  for (int i = 0; i < 37; ++i) {
+    d.pushBack(std::to_string(i));
+    expected.push_back(std::to_string(i));
+  }
+  d.pushFront("front");
+  expected.push_front("front");
+
+  std::vector<std::string> copied;
+  deque::copy(d.cbegin(), d.cend(), std::back_inserter(copied));
+  assert(copied.size() == expected.size());
+  assert(std::equal(copied.begin(), copied.end(), expected.begin()));
+
+  std::size_t visited = 0;
+  deque::forEach(d.begin() + 3, d.end() - 2, [&visited](const std::string&) { ++visited; });
+  assert(visited == d.size() - 5);
+
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    auto it = deque::find(d.begin(), d.end(), expected[i]);
+    assert(it == d.begin() + static_cast<std::ptrdiff_t>(i));
+  }
+  assert(deque::find(d.begin(), d.end(), std::string("missing")) == d.end());
+  assert(deque::find(d.begin() + 10, d.end(), std::string("0")) == d.end());
+
+  std::string joined = deque::accumulate(d.cbegin(), d.cend(), std::string());
+  assert(joined == std::accumulate(expected.begin(), expected.end(), std::string()));
+
+  deque::fill(d.begin() + 5, d.begin() + 30, std::string("x"));
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    assert(d[i] == (i >= 5 && i < 30 ? "x" : expected[i]));
+  }
+
+  deque::Deque<long long> numbers;
+  for (long long i = 1; i <= 100000; ++i) {
+    numbers.pushBack(i);
+  }
+  assert(deque::accumulate(numbers.begin(), numbers.end(), 0LL) == 100000LL * 100001LL / 2);
+  assert(deque::accumulate(numbers.begin(), numbers.begin() + 4, 1LL, [](long long a, long long b) { return a * b; }) ==
+         24);
+}
+
+void runSegmentTests() {
+  testSegmentsCoverRange();
+  testSegmentsMutate();
+  testSegmentedAlgorithms();
+}
@@ -0,0 +1,224 @@
+//验证内联小缓冲区 SmallDeque
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "deque/small_deque.hpp"
+
+static void testInlineDoesNotAllocate() {
+  static_assert(std::is_nothrow_default_constructible_v<deque::SmallDeque<int, 8>>,
+                "empty construction must be noexcept");
+
+  // 空资源上任何分配都会抛出 bad_alloc：内联容量内的操作必须完全不分配。
+  using PmrSmall = deque::SmallDeque<int, 8, std::pmr::polymorphic_allocator<int>>;
+  PmrSmall d(std::pmr::null_memory_resource());
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 8; ++i) {
+      i % 2 == 0 ? d.pushBack(i) : d.pushFront(i);
+    }
+    assert(d.size() == 8 && d.isInline());
+    while (!d.empty()) {
+      d.popFront();
+    }
+  }
+
+  bool threw = false;
+  for (int i = 0; i < 9; ++i) {
+    try {
+      d.pushBack(i);
+    } catch (const std::bad_alloc&) {
+      threw = true;
+    }
+  }
+  assert(threw);
+}
+
+static void testSpillAndReturn() {
+  deque::SmallDeque<std::string, 4> d;
+  std::deque<std::string> expected;
+  for (int i = 0; i < 4; ++i) {
+    d.pushBack(std::to_string(i));
+    expected.push_back(std::to_string(i));
+  }
+  assert(d.isInline());
+
+  // 参数引用内联元素时溢出仍然正确。
+  d.pushFront(d.back());
+  expected.push_front(expected.back());
+  assert(!d.isInline());
+  assert(std::equal(d.begin(), d.end(), expected.begin(), expected.end()));
+
+  for (int i = 0; i < 100; ++i) {
+    d.emplaceBack(3, static_cast<char>('a' + i % 26));
+    expected.emplace_back(3, static_cast<char>('a' + i % 26));
+  }
+  assert(std::equal(d.rBegin(), d.rEnd(), expected.rbegin(), expected.rend()));
+
+  while (!d.empty()) {
+    assert(d.front() == expected.front());
+    d.popFront();
+    expected.pop_front();
+  }
+  assert(d.isInline());
+  d.pushBack("again");
+  assert(d.isInline() && d.size() == 1);
+}
+
+static void testRandomAgainstStd() {
+  std::mt19937 rng(11);
+  deque::SmallDeque<int, 6> d;
+  std::deque<int> expected;
+  for (int step = 0; step < 20000; ++step) {
+    unsigned op = rng() % 6;
+    if (op < 2) {
+      d.pushBack(step);
+      expected.push_back(step);
+    } else if (op < 3) {
+      d.pushFront(step);
+      expected.push_front(step);
+    } else if (!expected.empty()) {
+      if (op < 5) {
+        d.popFront();
+        expected.pop_front();
+      } else {
+        d.popBack();
+        expected.pop_back();
+      }
+    }
+    if (step % 1000 == 0) {
+      d.clear();
+      expected.clear();
+      assert(d.isInline());
+    }
+    assert(d.size() == expected.size());
+  }
+  assert(std::equal(d.begin(), d.end(), expected.begin(), expected.end()));
+}
+
+static void testCopyMove() {
+  deque::SmallDeque<std::string, 3> small;
+  small.pushBack("a");
+  deque::SmallDeque<std::string, 3> big;
+  for (int i = 0; i < 10; ++i) {
+    big.pushBack(std::to_string(i));
+  }
+
+  auto small_copy = small;
+  auto big_copy = big;
+  assert(small_copy == small && small_copy.isInline());
+  assert(big_copy == big && !big_copy.isInline());
+
+  auto moved = std::move(big_copy);
+  assert(moved == big);
+  assert(big_copy.empty() && big_copy.isInline());
+  big_copy.pushBack("usable");
+  assert(big_copy.size() == 1);
+
+  swap(small_copy, moved);
+  assert(small_copy == big && moved == small);
+  moved = big;
+  assert(moved == big);
+  assert(big < small);
+}
+
+// 两个不同资源上的 pmr 分配器互相赋值：分配器不传播，元素按目标自己的资源重新存放
+static void testPmrAssignment() {
+  using PmrSmall = deque::SmallDeque<std::pmr::string, 3, std::pmr::polymorphic_allocator<std::pmr::string>, 16>;
+  std::pmr::monotonic_buffer_resource first;
+  std::pmr::monotonic_buffer_resource second;
+  for (int count : {2, 40}) {
+    PmrSmall source(&first);
+    for (int i = 0; i < count; ++i) {
+      source.pushBack(std::pmr::string(20, static_cast<char>('a' + i % 26)));
+    }
+    PmrSmall copied(&second);
+    copied.pushBack("old");
+    copied = source;
+    assert(copied == source && copied.getAllocator().resource() == &second);
+
+    PmrSmall moved(&second);
+    for (int i = 0; i < 10; ++i) {
+      moved.pushFront("old");
+    }
+    moved = std::move(copied);
+    assert(moved == source && moved.getAllocator().resource() == &second);
+    assert(copied.empty() && copied.getAllocator().resource() == &second);
+
+    // 资源相同时移动赋值直接接管
+    PmrSmall same(&first);
+    same = std::move(source);
+    assert(same == moved && same.getAllocator().resource() == &first);
+    assert(source.empty());
+  }
+}
+
+// 溢出时分配或复制失败，容器保持原样，仍在内联模式
+struct ThrowingCopy {
+  static inline int copies_left = 1000;
+
+  int value = 0;
+  ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  // 移动可能抛出：溢出时改为复制
+  ThrowingCopy(ThrowingCopy&& other) noexcept(false) : value(other.value) {}
+  ThrowingCopy& operator=(const ThrowingCopy&) = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) = default;
+
+  bool operator==(const ThrowingCopy& other) const { return value == other.value; }
+};
+
+static void testSpillIsAllOrNothing() {
+  using PmrSmall = deque::SmallDeque<int, 4, std::pmr::polymorphic_allocator<int>>;
+  PmrSmall d(std::pmr::null_memory_resource());
+  for (int i = 0; i < 4; ++i) {
+    d.pushBack(i);
+  }
+  bool threw = false;
+  try {
+    d.pushBack(4);
+  } catch (const std::bad_alloc&) {
+    threw = true;
+  }
+  assert(threw && d.isInline() && d.size() == 4);
+  for (int i = 0; i < 4; ++i) {
+    assert(d[static_cast<std::size_t>(i)] == i);
+  }
+
+  deque::SmallDeque<ThrowingCopy, 4> t;
+  for (int i = 0; i < 4; ++i) {
+    t.pushBack(ThrowingCopy(i));
+  }
+  ThrowingCopy::copies_left = 2;
+  threw = false;
+  try {
+    t.pushBack(ThrowingCopy(4));
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ThrowingCopy::copies_left = 1000;
+  assert(threw && t.isInline() && t.size() == 4);
+  for (int i = 0; i < 4; ++i) {
+    assert(t[static_cast<std::size_t>(i)].value == i);
+  }
+  t.pushBack(ThrowingCopy(4));
+  assert(!t.isInline() && t.size() == 5 && t.back().value == 4 && t.front().value == 0);
+}
+
+void runSmallTests() {
+  testInlineDoesNotAllocate();
+  testSpillAndReturn();
+  testRandomAgainstStd();
+  testCopyMove();
+  testPmrAssignment();
+  testSpillIsAllOrNothing();
+}
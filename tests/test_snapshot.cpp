@@ -0,0 +1,260 @@
+//验证写时复制快照 SnapshotDeque（块共享、按块复制、元素生命周期、跨线程读取）
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "deque/algorithm.hpp"
+#include "deque/snapshot_deque.hpp"
+
+namespace {
+
+using Snap = deque::SnapshotDeque<int, std::allocator<int>, 16>;
+
+template <class MyDeque, class T>
+void assertSame(const MyDeque& my_deque, const std::deque<T>& std_deque) {
+  assert(my_deque.size() == std_deque.size());
+  for (std::size_t i = 0; i < my_deque.size(); ++i) {
+    assert(my_deque[i] == std_deque[i]);
+  }
+  assert(std::equal(my_deque.begin(), my_deque.end(), std_deque.begin(), std_deque.end()));
+}
+
+// 统计存活实例数，检查共享块中的元素恰好析构一次
+struct Tracked {
+  static inline int live = 0;
+
+  int value = 0;
+  Tracked(int v) : value(v) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked& operator=(const Tracked& other) = default;
+  ~Tracked() { --live; }
+
+  bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+}  // namespace
+
+static void testSnapshotIsIndependent() {
+  Snap d;
+  std::deque<int> expected;
+  for (int i = 0; i < 100; ++i) {
+    d.pushBack(i);
+    expected.push_back(i);
+  }
+  auto before = d.blockStats();
+  Snap snap = d.snapshot();
+  // 快照只复制映射数组，不分配块
+  assert(d.blockStats().block_allocations == before.block_allocations);
+  assert(snap.blockStats().block_allocations == 0);
+  assert(d.sharedBlocks() == snap.sharedBlocks() && d.sharedBlocks() > 0);
+
+  d[50] = -50;
+  d.pushBack(100);
+  d.pushFront(-1);
+  d.popBack();
+  d.popFront();
+  d.popFront();
+  assert(d[49] == -50);
+  // 写入中间元素只复制了它所在的块，推入复制了两端的块
+  assert(d.blockStats().block_copies <= 3);
+  assertSame(snap, expected);
+
+  snap.popBack();
+  snap.back() = 7;
+  expected.pop_back();
+  expected.back() = 7;
+  assertSame(snap, expected);
+  assert(d[97] == 98 && d.back() == 99);
+
+  // 快照的快照，以及拷贝构造
+  Snap nested = snap.snapshot();
+  Snap copied(nested);
+  snap = Snap();
+  nested.pushBack(1);
+  expected.push_back(1);
+  assertSame(nested, expected);
+  expected.pop_back();
+  assertSame(copied, expected);
+}
+
+static void testRandomOperationsAgainstModel() {
+  std::mt19937 rng(23);
+  std::vector<Snap> deques(1);
+  std::vector<std::deque<int>> models(1);
+  for (int step = 0; step < 20000; ++step) {
+    std::size_t k = rng() % deques.size();
+    Snap& d = deques[k];
+    std::deque<int>& m = models[k];
+    int value = static_cast<int>(rng() % 1000);
+    switch (rng() % 9) {
+      case 0:
+      case 1:
+        d.pushBack(value);
+        m.push_back(value);
+        break;
+      case 2:
+        d.pushFront(value);
+        m.push_front(value);
+        break;
+      case 3:
+        if (!m.empty()) {
+          d.popBack();
+          m.pop_back();
+        }
+        break;
+      case 4:
+        if (!m.empty()) {
+          d.popFront();
+          m.pop_front();
+        }
+        break;
+      case 5:
+        if (!m.empty()) {
+          std::size_t index = rng() % m.size();
+          d[index] = value;
+          m[index] = value;
+        }
+        break;
+      case 6:
+        if (deques.size() < 8) {
+          deques.push_back(d.snapshot());
+          models.push_back(m);
+        }
+        break;
+      case 7:
+        if (deques.size() > 1) {
+          deques.erase(deques.begin() + static_cast<std::ptrdiff_t>(k));
+          models.erase(models.begin() + static_cast<std::ptrdiff_t>(k));
+        }
+        break;
+      default:
+        if (rng() % 50 == 0) {
+          d.clear();
+          m.clear();
+        }
+        break;
+    }
+    if (step % 97 == 0) {
+      for (std::size_t i = 0; i < deques.size(); ++i) {
+        assertSame(deques[i], models[i]);
+      }
+    }
+  }
+  for (std::size_t i = 0; i < deques.size(); ++i) {
+    assertSame(deques[i], models[i]);
+  }
+}
+
+static void testElementLifetime() {
+  {
+    deque::SnapshotDeque<Tracked, std::allocator<Tracked>, 16> d;
+    for (int i = 0; i < 200; ++i) {
+      d.pushBack(Tracked(i));
+    }
+    assert(Tracked::live == 200);
+    {
+      auto snap = d.snapshot();
+      assert(Tracked::live == 200);
+      // 共享块中弹出的元素仍被快照使用，不能析构
+      for (int i = 0; i < 50; ++i) {
+        d.popFront();
+        d.popBack();
+      }
+      assert(Tracked::live == 200);
+      d[0] = Tracked(-1);
+      assert(snap[50].value == 50);
+    }
+    // 快照释放后，原容器下一次写入独占块时清理遗留元素
+    d.pushFront(Tracked(-2));
+    d.pushBack(Tracked(-3));
+    assert(d.size() == 102);
+    assert(d.front().value == -2 && d.back().value == -3);
+  }
+  assert(Tracked::live == 0);
+
+  {
+    deque::SnapshotDeque<std::string, std::allocator<std::string>, 16> words;
+    for (int i = 0; i < 100; ++i) {
+      words.pushBack(std::string(30, static_cast<char>('a' + i % 26)));
+    }
+    auto snap = words.snapshot();
+    words.front() += "!";
+    assert(snap.front() == std::string(30, 'a'));
+    assert(words.front() == std::string(30, 'a') + "!");
+  }
+}
+
+static void testSegmentedAlgorithms() {
+  Snap d;
+  for (int i = 1; i <= 1000; ++i) {
+    d.pushBack(i);
+  }
+  auto snap = d.snapshot();
+  d[0] = 0;
+  assert(deque::accumulate(snap.begin(), snap.end(), 0) == 500500);
+  assert(deque::accumulate(d.begin(), d.end(), 0) == 500499);
+  std::size_t total = 0;
+  for (auto segment : snap.segments()) {
+    total += segment.size();
+  }
+  assert(total == 1000);
+}
+
+static void testAllocators() {
+  std::pmr::monotonic_buffer_resource resource;
+  deque::SnapshotDeque<int, std::pmr::polymorphic_allocator<int>, 16> d(&resource);
+  for (int i = 0; i < 100; ++i) {
+    d.pushBack(i);
+  }
+  // snapshot() 沿用同一资源并共享块；拷贝构造按 pmr 约定换回默认资源，只能复制元素
+  auto snap = d.snapshot();
+  assert(snap.getAllocator().resource() == &resource);
+  assert(snap.sharedBlocks() > 0);
+  auto copy = d;
+  assert(copy.getAllocator().resource() == std::pmr::get_default_resource());
+  assert(copy.sharedBlocks() == 0);
+  assert(copy == d && snap == d);
+}
+
+static void testSnapshotReadOnAnotherThread() {
+  Snap d;
+  for (int i = 0; i < 10000; ++i) {
+    d.pushBack(i);
+  }
+  std::vector<std::thread> readers;
+  for (int round = 0; round < 4; ++round) {
+    readers.emplace_back([snap = d.snapshot(), round]() mutable {
+      long long sum = 0;
+      for (int value : snap) {
+        sum += value;
+      }
+      assert(sum == 49995000LL + 10000LL * round);
+      snap.pushBack(0);
+    });
+    // 读者读取时原容器继续修改
+    for (int i = 0; i < 10000; ++i) {
+      d[static_cast<std::size_t>(i)] += 1;
+    }
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  assert(d.front() == 4 && d.back() == 10003);
+}
+
+void runSnapshotTests() {
+  testSnapshotIsIndependent();
+  testRandomOperationsAgainstModel();
+  testElementLifetime();
+  testSegmentedAlgorithms();
+  testAllocators();
+  testSnapshotReadOnAnotherThread();
+}
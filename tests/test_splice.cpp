@@ -0,0 +1,280 @@
+//验证按块转移所有权的拆分与拼接（splitAt、appendSplice、prependSplice）
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+#include "deque/deque.hpp"
+
+namespace {
+
+using SmallBlocks = deque::Deque<int, std::allocator<int>, 16>;
+
+template <class MyDeque, class T>
+void assertSame(const MyDeque& my_deque, const std::deque<T>& std_deque) {
+  assert(my_deque.size() == std_deque.size());
+  for (std::size_t i = 0; i < my_deque.size(); ++i) {
+    assert(my_deque[i] == std_deque[i]);
+  }
+}
+
+// 值为 first, first + 1, ...；头部推入 front_count 个，使起点落在块中间
+SmallBlocks makeRun(int first, int count, int front_count) {
+  SmallBlocks d;
+  for (int i = front_count; i < count; ++i) {
+    d.pushBack(first + i);
+  }
+  for (int i = front_count - 1; i >= 0; --i) {
+    d.pushFront(first + i);
+  }
+  return d;
+}
+
+std::deque<int> expectedRun(int first, int count) {
+  std::deque<int> expected;
+  for (int i = 0; i < count; ++i) {
+    expected.push_back(first + i);
+  }
+  return expected;
+}
+
+std::size_t residentBlocks(const SmallBlocks& d) { return d.blockStats().resident_blocks; }
+
+// 统计存活实例数；析构或移动一个从未构造的槽位时 magic 不对，直接触发断言
+struct Tracked {
+  static constexpr int alive = 0x5ca1ab1e;
+  static inline int live = 0;
+
+  int magic = alive;
+  int value = 0;
+  Tracked(int v) : value(v) { ++live; }
+  Tracked(Tracked&& other) noexcept : value(other.value) {
+    assert(other.magic == alive);
+    ++live;
+  }
+  Tracked& operator=(Tracked&& other) noexcept {
+    assert(magic == alive && other.magic == alive);
+    value = other.value;
+    return *this;
+  }
+  ~Tracked() {
+    assert(magic == alive);
+    magic = 0;
+    --live;
+  }
+};
+
+}  // namespace
+
+static void testSplitAt() {
+  for (int front_count : {0, 5, 16}) {
+    for (int index : {0, 1, 15, 16, 17, 37, 48, 99, 100}) {
+      SmallBlocks d = makeRun(0, 100, front_count);
+      std::size_t blocks_before = residentBlocks(d);
+      SmallBlocks tail = d.splitAt(static_cast<std::size_t>(index));
+
+      std::deque<int> all = expectedRun(0, 100);
+      assertSame(d, std::deque<int>(all.begin(), all.begin() + index));
+      assertSame(tail, std::deque<int>(all.begin() + index, all.end()));
+      // 最多新分配一个块（index 所在的块或自身新的 finish 块）
+      assert(tail.blockStats().block_allocations + d.blockStats().block_allocations <=
+             blocks_before + d.blockStats().block_deallocations + 1);
+      assert(residentBlocks(d) + residentBlocks(tail) <= blocks_before + 1);
+
+      // 拆分后的两个容器都可以继续正常使用
+      d.pushBack(-1);
+      d.pushFront(-2);
+      tail.pushFront(-3);
+      tail.pushBack(-4);
+      assert(d.back() == -1 && d.front() == -2);
+      assert(tail.front() == -3 && tail.back() == -4);
+    }
+  }
+
+  SmallBlocks empty;
+  SmallBlocks none = empty.splitAt(0);
+  assert(empty.empty() && none.empty());
+  none.pushBack(1);
+  assert(none.front() == 1);
+}
+
+static void testSplitThenRejoinTransfersBlocks() {
+  SmallBlocks d = makeRun(0, 1000, 7);
+  for (std::size_t index : {1, 100, 105, 500, 999}) {
+    SmallBlocks tail = d.splitAt(index);
+    auto before = d.blockStats();
+    // 拆分保留了块内偏移，重新拼接总是按块转移
+    d.appendSplice(std::move(tail));
+    auto after = d.blockStats();
+    assert(tail.empty());
+    // 尾部超过一个块时至少有整块被转交；只剩交界块时只搬移其中的元素
+    assert(index > 1000 - SmallBlocks::block_size || after.blocks_spliced_in > before.blocks_spliced_in);
+    assert(after.block_allocations == before.block_allocations);
+    assertSame(d, expectedRun(0, 1000));
+
+    SmallBlocks head = makeRun(0, 1000, 7);
+    SmallBlocks rest = head.splitAt(index);
+    rest.prependSplice(std::move(head));
+    assert(head.empty());
+    assertSame(rest, expectedRun(0, 1000));
+  }
+}
+
+static void testAppendAndPrependSplice() {
+  // 覆盖对齐与不对齐、长短两侧各自较短的情况
+  for (int front_a : {0, 3, 16}) {
+    for (int front_b : {0, 3, 9}) {
+      for (int count_a : {1, 20, 300}) {
+        for (int count_b : {1, 20, 300}) {
+          SmallBlocks a = makeRun(0, count_a, std::min(front_a, count_a));
+          SmallBlocks b = makeRun(count_a, count_b, std::min(front_b, count_b));
+          std::size_t blocks_before = residentBlocks(a) + residentBlocks(b);
+          a.appendSplice(std::move(b));
+          assertSame(a, expectedRun(0, count_a + count_b));
+          assert(b.empty());
+          // 没有泄漏的块：不对齐时被清空的一方最多在空闲缓存中留下 spareBlockLimit() 个块
+          assert(residentBlocks(a) + residentBlocks(b) <= blocks_before + b.spareBlockLimit() + 2);
+          b.pushBack(7);
+          assert(b.size() == 1 && b.front() == 7);
+
+          SmallBlocks c = makeRun(0, count_a, std::min(front_a, count_a));
+          SmallBlocks e = makeRun(count_a, count_b, std::min(front_b, count_b));
+          e.prependSplice(std::move(c));
+          assertSame(e, expectedRun(0, count_a + count_b));
+          assert(c.empty());
+          e.pushFront(-1);
+          e.pushBack(-2);
+          assert(e.front() == -1 && e.back() == -2);
+        }
+      }
+    }
+  }
+
+  // 任意一侧为空时直接接管
+  SmallBlocks target;
+  SmallBlocks source = makeRun(0, 50, 4);
+  target.appendSplice(std::move(source));
+  assertSame(target, expectedRun(0, 50));
+  assert(target.blockStats().block_allocations == 0);
+  target.appendSplice(SmallBlocks());
+  target.prependSplice(SmallBlocks());
+  assertSame(target, expectedRun(0, 50));
+}
+
+static void testSpliceNonTrivialElements() {
+  deque::Deque<std::string, std::allocator<std::string>, 16> a;
+  deque::Deque<std::string, std::allocator<std::string>, 16> b;
+  std::deque<std::string> expected;
+  for (int i = 0; i < 70; ++i) {
+    a.pushBack("a" + std::to_string(i) + std::string(20, 'x'));
+    expected.push_back(a.back());
+  }
+  for (int i = 0; i < 45; ++i) {
+    b.pushBack("b" + std::to_string(i) + std::string(20, 'y'));
+    expected.push_back(b.back());
+  }
+  a.appendSplice(std::move(b));
+  assertSame(a, expected);
+
+  auto tail = a.splitAt(33);
+  a.prependSplice(std::move(tail));
+  std::deque<std::string> rotated(expected.begin() + 33, expected.end());
+  rotated.insert(rotated.end(), expected.begin(), expected.begin() + 33);
+  assertSame(a, rotated);
+}
+
+// front 只占一个块且起点不在块首时，交界块中起点之前的槽位没有构造过，不能搬移或析构
+static void testSpliceSingleBlockFront() {
+  using TrackedDeque = deque::Deque<Tracked, std::allocator<Tracked>, 16>;
+  for (int front_count : {1, 3, 7}) {
+    for (int back_count : {1, 9, 40}) {
+      {
+        TrackedDeque a;
+        TrackedDeque b;
+        for (int i = front_count - 1; i >= 0; --i) {
+          a.pushFront(Tracked(i));
+        }
+        for (int i = 0; i < back_count; ++i) {
+          b.pushBack(Tracked(front_count + i));
+        }
+        a.appendSplice(std::move(b));
+        assert(b.empty());
+        assert(Tracked::live == front_count + back_count);
+        assert(a.size() == static_cast<std::size_t>(front_count + back_count));
+        for (int i = 0; i < front_count + back_count; ++i) {
+          assert(a[static_cast<std::size_t>(i)].value == i);
+        }
+
+        TrackedDeque c;
+        TrackedDeque e;
+        for (int i = front_count - 1; i >= 0; --i) {
+          c.pushFront(Tracked(i));
+        }
+        for (int i = 0; i < back_count; ++i) {
+          e.pushBack(Tracked(front_count + i));
+        }
+        e.prependSplice(std::move(c));
+        assert(c.empty());
+        assert(Tracked::live == 2 * (front_count + back_count));
+        for (int i = 0; i < front_count + back_count; ++i) {
+          assert(e[static_cast<std::size_t>(i)].value == i);
+        }
+      }
+      assert(Tracked::live == 0);
+    }
+  }
+
+  deque::Deque<std::string, std::allocator<std::string>, 16> words;
+  deque::Deque<std::string, std::allocator<std::string>, 16> more;
+  std::deque<std::string> expected;
+  for (int i = 2; i >= 0; --i) {
+    words.pushFront(std::string(30, static_cast<char>('a' + i)));
+    expected.push_front(words.front());
+  }
+  for (int i = 0; i < 40; ++i) {
+    more.pushBack(std::string(30, static_cast<char>('k' + i % 10)));
+    expected.push_back(more.back());
+  }
+  words.appendSplice(std::move(more));
+  assertSame(words, expected);
+}
+
+static void testSpliceWithUnequalAllocators() {
+  std::pmr::monotonic_buffer_resource first_resource;
+  std::pmr::monotonic_buffer_resource second_resource;
+  deque::pmr::Deque<int, 16> a(&first_resource);
+  deque::pmr::Deque<int, 16> b(&second_resource);
+  for (int i = 0; i < 100; ++i) {
+    a.pushBack(i);
+  }
+  for (int i = 100; i < 150; ++i) {
+    b.pushBack(i);
+  }
+  // 分配器不相等时不能转移块，元素逐个移动到 a 的块中
+  a.appendSplice(std::move(b));
+  assert(b.empty());
+  assert(a.blockStats().blocks_spliced_in == 0);
+  assert(a.getAllocator().resource() == &first_resource);
+  assertSame(a, expectedRun(0, 150));
+
+  deque::pmr::Deque<int, 16> c(&second_resource);
+  for (int i = -30; i < 0; ++i) {
+    c.pushBack(i);
+  }
+  a.prependSplice(std::move(c));
+  assert(c.empty());
+  assertSame(a, expectedRun(-30, 180));
+}
+
+void runSpliceTests() {
+  testSplitAt();
+  testSplitThenRejoinTransfersBlocks();
+  testAppendAndPrependSplice();
+  testSpliceNonTrivialElements();
+  testSpliceSingleBlockFront();
+  testSpliceWithUnequalAllocators();
+}
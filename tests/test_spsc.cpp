@@ -0,0 +1,135 @@
+//验证单生产者单消费者无锁队列 SpscDeque
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "deque/spsc_deque.hpp"
+
+namespace {
+
+struct Counted {
+  static int live;
+  int value = 0;
+
+  Counted() { ++live; }
+  Counted(int v) : value(v) { ++live; }
+  Counted(const Counted& other) : value(other.value) { ++live; }
+  Counted(Counted&& other) noexcept : value(other.value) { ++live; }
+  Counted& operator=(const Counted&) = default;
+  Counted& operator=(Counted&&) noexcept = default;
+  ~Counted() { --live; }
+};
+
+int Counted::live = 0;
+
+}  // namespace
+
+static void testSingleThreaded() {
+  deque::SpscDeque<int, std::allocator<int>, 4> q;
+  int out = 0;
+  assert(q.emptyApprox());
+  assert(!q.tryPopFront(out));
+
+  // 跨越多个块的推入/弹出，块会被回收后复用。
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 0; i < 37; ++i) {
+      assert(q.tryPushBack(i));
+    }
+    assert(q.sizeApprox() == 37);
+    for (int i = 0; i < 37; ++i) {
+      assert(q.tryPopFront(out));
+      assert(out == i);
+    }
+    assert(!q.tryPopFront(out));
+  }
+}
+
+static void testBoundedAndBulk() {
+  deque::SpscDeque<int, std::allocator<int>, 8> q(20);
+  assert(q.capacity() == 20);
+
+  std::vector<int> input;
+  for (int i = 0; i < 50; ++i) {
+    input.push_back(i);
+  }
+  assert(q.tryPushBulk(input.begin(), input.size()) == 20);
+  assert(!q.tryPushBack(99));
+
+  std::vector<int> output(50, -1);
+  assert(q.tryPopBulk(output.begin(), 7) == 7);
+  assert(q.tryPushBulk(input.begin() + 20, 30) == 7);
+  assert(q.tryPopBulk(output.begin() + 7, 50) == 20);
+  assert(q.tryPopBulk(output.begin(), 50) == 0);
+  for (int i = 0; i < 27; ++i) {
+    assert(output[static_cast<std::size_t>(i)] == i);
+  }
+}
+
+static void testDestroysRemaining() {
+  Counted::live = 0;
+  {
+    deque::SpscDeque<Counted, std::allocator<Counted>, 4> q;
+    for (int i = 0; i < 30; ++i) {
+      q.tryEmplaceBack(i);
+    }
+    Counted out;
+    for (int i = 0; i < 11; ++i) {
+      assert(q.tryPopFront(out));
+      assert(out.value == i);
+    }
+    assert(Counted::live == 19 + 1);
+  }
+  assert(Counted::live == 0);
+}
+
+static void testTwoThreads() {
+  constexpr int count = 200000;
+  deque::SpscDeque<std::string, std::allocator<std::string>, 16> q(1000);
+
+  std::thread producer([&q] {
+    deque::detail::Backoff backoff;
+    for (int i = 0; i < count;) {
+      if (i % 3 == 0) {
+        std::string batch[5];
+        int n = std::min(5, count - i);
+        for (int k = 0; k < n; ++k) {
+          batch[k] = std::to_string(i + k);
+        }
+        std::size_t pushed = q.tryPushBulk(batch, static_cast<std::size_t>(n));
+        i += static_cast<int>(pushed);
+        pushed == 0 ? backoff.pause() : backoff.reset();
+      } else if (q.tryPushBack(std::to_string(i))) {
+        ++i;
+        backoff.reset();
+      } else {
+        backoff.pause();
+      }
+    }
+  });
+
+  deque::detail::Backoff backoff;
+  int expected = 0;
+  std::vector<std::string> batch(7);
+  while (expected < count) {
+    std::size_t popped = q.tryPopBulk(batch.begin(), batch.size());
+    for (std::size_t k = 0; k < popped; ++k) {
+      assert(batch[k] == std::to_string(expected));
+      ++expected;
+    }
+    popped == 0 ? backoff.pause() : backoff.reset();
+  }
+  producer.join();
+  std::string out;
+  assert(!q.tryPopFront(out));
+}
+
+void runSpscTests() {
+  testSingleThreaded();
+  testBoundedAndBulk();
+  testDestroysRemaining();
+  testTwoThreads();
+}
@@ -2,23 +2,27 @@
 #include <cassert>
 #include <cstddef>
 #include <deque>
+#include <memory>
 #include <random>
 #include <vector>
 
 #include "deque/deque.hpp"
 
-static void assertSame(const deque::Deque<int>& my_deque, const std::deque<int>& std_deque) {
+template <class MyDeque>
+static void assertSame(const MyDeque& my_deque, const std::deque<int>& std_deque) {
   assert(my_deque.size() == std_deque.size());
   for (std::size_t i = 0; i < my_deque.size(); ++i) {
     assert(my_deque[i] == std_deque[i]);
   }
 }
 
-void runVsStdDequeTests() {
-  deque::Deque<int> my_deque;
+template <class MyDeque>
+static void runRandomOperations(unsigned seed, const typename MyDeque::map_growth_policy& policy = {}) {
+  MyDeque my_deque;
+  my_deque.setMapGrowthPolicy(policy);
   std::deque<int> std_deque;
 
-  std::mt19937 rng(12345);
+  std::mt19937 rng(seed);
   std::uniform_int_distribution<int> op_dist(0, 7);
   std::uniform_int_distribution<int> val_dist(-1000, 1000);
 
@@ -60,13 +64,46 @@ void runVsStdDequeTests() {
       int value = val_dist(rng);
       my_deque.resize(new_size, value);
       std_deque.resize(new_size, value);
-    } else {  // clear
-      if ((rng() % 50) == 0) {
+    } else {  // clear / reserve / shrinkToFit，只改变容量，内容必须不变
+      auto pick = rng() % 50;
+      if (pick == 0) {
         my_deque.clear();
         std_deque.clear();
+      } else if (pick < 4) {
+        my_deque.reserveBack(rng() % 100);
+      } else if (pick < 7) {
+        my_deque.reserveFront(rng() % 100);
+      } else if (pick == 7) {
+        my_deque.shrinkToFit();
       }
     }
 
     assertSame(my_deque, std_deque);
   }
 }
+
+void runVsStdDequeTests() {
+  runRandomOperations<deque::Deque<int>>(12345);
+  // 小块尺寸：让随机操作频繁跨越块边界
+  runRandomOperations<deque::Deque<int, std::allocator<int>, 8>>(12345);
+  // 非 2 的幂块尺寸走除法/取模分支
+  runRandomOperations<deque::Deque<int, std::allocator<int>, 24>>(54321);
+  // 各种映射数组增长策略只影响布局，不影响内容
+  using SmallBlocks = deque::Deque<int, std::allocator<int>, 8>;
+  SmallBlocks::map_growth_policy policy;
+  policy.growth_factor = 1.5;
+  runRandomOperations<SmallBlocks>(777, policy);
+  policy.recenter_in_place = false;
+  runRandomOperations<SmallBlocks>(778, policy);
+  policy.bias_to_hot_end = false;
+  policy.growth_factor = 4.0;
+  runRandomOperations<SmallBlocks>(779, policy);
+  // 增量增长：搬移进行中穿插插入、删除、clear、预留与收缩
+  SmallBlocks::map_growth_policy incremental;
+  incremental.incremental = true;
+  runRandomOperations<SmallBlocks>(780, incremental);
+  using OddBlocks = deque::Deque<int, std::allocator<int>, 24>;
+  OddBlocks::map_growth_policy odd_incremental;
+  odd_incremental.incremental = true;
+  runRandomOperations<OddBlocks>(781, odd_incremental);
+}
@@ -0,0 +1,107 @@
+//验证 Chase–Lev 工作窃取队列 WorkStealingDeque
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "deque/detail/concurrent.hpp"
+#include "deque/work_stealing_deque.hpp"
+
+static void testOwnerOnly() {
+  deque::WorkStealingDeque<int, 4> d;
+  assert(d.capacity() == 4);
+  assert(!d.pop());
+  assert(!d.steal());
+
+  // 所有者端是 LIFO，窃取端是 FIFO。
+  for (int i = 0; i < 3; ++i) {
+    d.push(i);
+  }
+  assert(*d.steal() == 0);
+  assert(*d.pop() == 2);
+  assert(*d.pop() == 1);
+  assert(!d.pop());
+}
+
+static void testGrowKeepsOrder() {
+  deque::WorkStealingDeque<int, 4> d;
+  int next = 0;
+  int stolen = 0;
+  // 先推进 top 让环形下标错开块边界，再反复扩容，包括活跃元素跨越新环两半的情况。
+  for (int round = 0; round < 6; ++round) {
+    for (int i = 0; i < 7 + round * 5; ++i) {
+      d.push(next++);
+    }
+    for (int i = 0; i < 3; ++i) {
+      assert(*d.steal() == stolen++);
+    }
+  }
+  assert(d.capacity() >= d.sizeApprox());
+  while (auto value = d.steal()) {
+    assert(*value == stolen++);
+  }
+  assert(stolen == next);
+}
+
+static void testConcurrentSteal() {
+  constexpr int task_count = 200000;
+  constexpr int thief_count = 3;
+  deque::WorkStealingDeque<int, 16> d;
+  std::vector<std::atomic<int>> seen(task_count);
+  std::atomic<int> taken{0};
+
+  auto take = [&](int value) {
+    assert(value >= 0 && value < task_count);
+    int previous = seen[static_cast<std::size_t>(value)].fetch_add(1, std::memory_order_relaxed);
+    assert(previous == 0);
+    (void)previous;
+    taken.fetch_add(1, std::memory_order_relaxed);
+  };
+
+  std::vector<std::thread> thieves;
+  for (int k = 0; k < thief_count; ++k) {
+    thieves.emplace_back([&] {
+      deque::detail::Backoff backoff;
+      while (taken.load(std::memory_order_relaxed) < task_count) {
+        if (auto value = d.steal()) {
+          take(*value);
+          backoff.reset();
+        } else {
+          backoff.pause();
+        }
+      }
+    });
+  }
+
+  // 所有者交替地批量压入与弹出，迫使多次扩容并在最后一个元素上与窃取者竞争。
+  int pushed = 0;
+  while (pushed < task_count) {
+    int burst = 1 + pushed % 97;
+    for (int i = 0; i < burst && pushed < task_count; ++i) {
+      d.push(pushed++);
+    }
+    for (int i = 0; i < burst / 3; ++i) {
+      if (auto value = d.pop()) {
+        take(*value);
+      }
+    }
+  }
+  while (auto value = d.pop()) {
+    take(*value);
+  }
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  assert(taken.load() == task_count);
+  for (auto& count : seen) {
+    assert(count.load() == 1);
+  }
+}
+
+void runWorkStealingTests() {
+  testOwnerOnly();
+  testGrowKeepsOrder();
+  testConcurrentSteal();
+}